@@ -0,0 +1,385 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// Throughput of the transcoding views over generated corpora, reported in
+// GiB/s of input. Usage: beman.utf_view.benchmarks [filter], where only
+// benchmarks whose names contain filter are run.
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/code_unit_view.hpp>
+#include <beman/utf_view/endian_view.hpp>
+#include <beman/utf_view/from_bom_view.hpp>
+#include <beman/utf_view/parallel_transcode.hpp>
+#include <beman/utf_view/to_utf_readahead.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcode.hpp>
+#include <beman/utf_view/utf_distance.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <execution>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+
+namespace {
+
+using namespace beman::utf_view;
+
+constexpr std::size_t corpus_utf8_size = 1 << 20;
+constexpr std::chrono::milliseconds min_time{200};
+
+std::uint32_t volatile sink;
+
+struct corpus {
+  char const* name;
+  std::u8string utf8;
+  std::u16string utf16;
+  std::u32string utf32;
+  bool well_formed;
+
+  template <class CharT>
+  std::basic_string<CharT> const& units() const {
+    if constexpr (std::is_same_v<CharT, char8_t>) {
+      return utf8;
+    } else if constexpr (std::is_same_v<CharT, char16_t>) {
+      return utf16;
+    } else {
+      return utf32;
+    }
+  }
+};
+
+enum class script { latin, arabic, cjk, emoji, mixed };
+
+char32_t random_code_point(std::mt19937& rng, script s) {
+  auto const in = [&rng](char32_t lo, char32_t hi) {
+    return static_cast<char32_t>(std::uniform_int_distribution<std::uint32_t>{lo, hi}(rng));
+  };
+  switch (s) {
+  case script::latin:
+    // Mostly ASCII, with the occasional accented letter.
+    return std::uniform_int_distribution{0, 9}(rng) ? in(U'a', U'z') : in(U'À', U'ſ');
+  case script::arabic:
+    return in(U'ء', U'ي');
+  case script::cjk:
+    return in(U'一', U'鿿');
+  case script::emoji:
+    return std::uniform_int_distribution{0, 1}(rng) ? in(U'\U0001F300', U'\U0001F64F')
+                                                    : in(U'\U0001F900', U'\U0001F9FF');
+  case script::mixed:
+    break;
+  }
+  return U'?';
+}
+
+// Words of two to eight code points separated by ASCII spaces and
+// punctuation, so that every script has the short ASCII runs real text does.
+// A mixed corpus picks the script of each word at random.
+std::u32string generate_text(std::mt19937& rng, script s) {
+  std::u32string text;
+  std::size_t utf8_size{};
+  while (utf8_size < corpus_utf8_size) {
+    script const word_script{s == script::mixed
+                                 ? static_cast<script>(std::uniform_int_distribution{0, 3}(rng))
+                                 : s};
+    for (int n = std::uniform_int_distribution{2, 8}(rng); n != 0; --n) {
+      char32_t const c{random_code_point(rng, word_script)};
+      text.push_back(c);
+      utf8_size += c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+    }
+    text.push_back(std::uniform_int_distribution{0, 7}(rng) ? U' ' : U'.');
+    ++utf8_size;
+  }
+  return text;
+}
+
+corpus make_corpus(char const* name, std::mt19937& rng, script s) {
+  std::u32string const text{generate_text(rng, s)};
+  return {.name = name,
+          .utf8 = text | to_utf8 | std::ranges::to<std::u8string>(),
+          .utf16 = text | to_utf16 | std::ranges::to<std::u16string>(),
+          .utf32 = text,
+          .well_formed = true};
+}
+
+// Overwrite roughly one code unit in every period with a value drawn from
+// [lo, hi], which for each encoding below is mostly ill-formed.
+template <class CharT>
+void corrupt(std::mt19937& rng, std::basic_string<CharT>& units, std::size_t period, std::uint32_t lo,
+             std::uint32_t hi) {
+  std::uniform_int_distribution<std::size_t> position{0, period - 1};
+  std::uniform_int_distribution<std::uint32_t> value{lo, hi};
+  for (std::size_t i = 0; i + period <= units.size(); i += period) {
+    units[i + position(rng)] = static_cast<CharT>(value(rng));
+  }
+}
+
+std::vector<corpus> make_corpora() {
+  std::mt19937 rng{20260401};
+  std::vector<corpus> corpora;
+  corpora.push_back(make_corpus("latin", rng, script::latin));
+  corpora.push_back(make_corpus("arabic", rng, script::arabic));
+  corpora.push_back(make_corpus("cjk", rng, script::cjk));
+  corpora.push_back(make_corpus("emoji", rng, script::emoji));
+  corpora.push_back(make_corpus("mixed", rng, script::mixed));
+  corpus corrupted{make_corpus("corrupted", rng, script::mixed)};
+  corrupt(rng, corrupted.utf8, 1000, 0x80, 0xFF);
+  corrupt(rng, corrupted.utf16, 500, 0xD800, 0xDFFF);
+  corrupt(rng, corrupted.utf32, 250, 0xD800, 0xDFFF);
+  corrupted.well_formed = false;
+  corpora.push_back(std::move(corrupted));
+  return corpora;
+}
+
+template <class V>
+std::uint32_t consume(V&& view) {
+  std::uint32_t sum{};
+  for (auto const c : view) {
+    if constexpr (std::is_integral_v<std::remove_cv_t<decltype(c)>>) {
+      sum += c;
+    } else {
+      sum += c ? static_cast<std::uint32_t>(*c) : 0;
+    }
+  }
+  return sum;
+}
+
+template <class CharT>
+char const* encoding_name() {
+  if constexpr (std::is_same_v<CharT, char8_t>) {
+    return "utf8";
+  } else if constexpr (std::is_same_v<CharT, char16_t>) {
+    return "utf16";
+  } else {
+    return "utf32";
+  }
+}
+
+class runner {
+  std::string_view filter_;
+
+public:
+  explicit runner(std::string_view filter) : filter_{filter} {}
+
+  // Run f until min_time has passed and print the input throughput.
+  template <class F>
+  void operator()(std::string const& name, std::size_t input_bytes, F f) const {
+    if (name.find(filter_) == std::string::npos) {
+      return;
+    }
+    using clock = std::chrono::steady_clock;
+    sink = f();
+    std::size_t iterations{};
+    clock::time_point const start{clock::now()};
+    clock::duration elapsed{};
+    do {
+      sink = f();
+      ++iterations;
+      elapsed = clock::now() - start;
+    } while (elapsed < min_time);
+    double const seconds{std::chrono::duration<double>(elapsed).count()};
+    double const gib{static_cast<double>(input_bytes) * static_cast<double>(iterations) / (1 << 30)};
+    std::printf("%-52s %8.3f\n", name.c_str(), gib / seconds);
+  }
+};
+
+template <class FromType, class ToType>
+void bench_to_utf(runner const& run, corpus const& c) {
+  std::basic_string_view<FromType> const input{c.units<FromType>()};
+  std::size_t const bytes{input.size() * sizeof(FromType)};
+  std::string const suffix{std::string{"/"} + encoding_name<FromType>() + "/" + c.name};
+  std::string const to{std::string{"to_"} + encoding_name<ToType>()};
+  run(to + suffix, bytes, [input] { return consume(input | to_utf<ToType>); });
+  run(to + "_or_error" + suffix, bytes, [input] { return consume(input | to_utf_or_error<ToType>); });
+  run(to + "_readahead" + suffix, bytes, [input] { return consume(input | to_utf_readahead<ToType>); });
+  if (c.well_formed) {
+    run(to + "_assume_valid" + suffix, bytes, [input] { return consume(input | to_utf_assume_valid<ToType>); });
+  }
+  std::vector<ToType> out(input.size() * 4 / sizeof(ToType) + 4);
+  run("transcode<" + to.substr(3) + ">" + suffix, bytes, [input, &out] {
+    return static_cast<std::uint32_t>(transcode<ToType>(input, out.data()).out - out.data());
+  });
+  run("transcode<" + to.substr(3) + ",par>" + suffix, bytes, [input, &out] {
+    return static_cast<std::uint32_t>(transcode<ToType>(std::execution::par, input, out.data()).out - out.data());
+  });
+}
+
+template <class FromType>
+void bench_from(runner const& run, corpus const& c) {
+  bench_to_utf<FromType, char8_t>(run, c);
+  bench_to_utf<FromType, char16_t>(run, c);
+  bench_to_utf<FromType, char32_t>(run, c);
+}
+
+template <class CharT>
+std::basic_string<CharT> byteswapped(std::basic_string<CharT> units) {
+  for (CharT& unit : units) {
+    unit = std::byteswap(unit);
+  }
+  return units;
+}
+
+// The endian and code unit adaptors in front of to_utf, as they would be
+// used on bytes read from a file or a network buffer.
+void bench_adaptors(runner const& run, corpus const& c) {
+  std::string const suffix{std::string{"/"} + c.name};
+
+  std::string const chars(c.utf8.begin(), c.utf8.end());
+  std::string_view const char_input{chars};
+  run("as_char8_t|to_utf16" + suffix, chars.size(),
+      [char_input] { return consume(char_input | as_char8_t | to_utf16); });
+  std::vector<char16_t> chars_out(chars.size());
+  run("transcode<utf16>(as_char8_t)" + suffix, chars.size(), [char_input, &chars_out] {
+    return static_cast<std::uint32_t>(transcode<char16_t>(char_input | as_char8_t, chars_out.data()).out -
+                                      chars_out.data());
+  });
+
+  std::vector<std::uint16_t> const u16_ints(c.utf16.begin(), c.utf16.end());
+  std::size_t const utf16_bytes{c.utf16.size() * sizeof(char16_t)};
+  run("as_char16_t|to_utf8" + suffix, utf16_bytes,
+      [&u16_ints] { return consume(u16_ints | as_char16_t | to_utf8); });
+
+  std::u16string const big_endian16{std::endian::native == std::endian::big ? c.utf16
+                                                                             : byteswapped(c.utf16)};
+  std::u16string const little_endian16{std::endian::native == std::endian::little ? c.utf16
+                                                                                   : byteswapped(c.utf16)};
+  std::u16string_view const be16{big_endian16};
+  std::u16string_view const le16{little_endian16};
+  run("from_big_endian|to_utf8/utf16be" + suffix, utf16_bytes,
+      [be16] { return consume(be16 | from_big_endian | to_utf8); });
+  run("from_little_endian|to_utf8/utf16le" + suffix, utf16_bytes,
+      [le16] { return consume(le16 | from_little_endian | to_utf8); });
+  std::vector<char8_t> out(c.utf16.size() * 3);
+  run("transcode<utf8>(from_big_endian)/utf16be" + suffix, utf16_bytes, [be16, &out] {
+    return static_cast<std::uint32_t>(transcode<char8_t>(be16 | from_big_endian, out.data()).out - out.data());
+  });
+  std::vector<std::uint16_t> const be16_ints(be16.begin(), be16.end());
+  run("from_big_endian|as_char16_t|to_utf8/utf16be" + suffix, utf16_bytes,
+      [&be16_ints] { return consume(be16_ints | from_big_endian | as_char16_t | to_utf8); });
+
+  std::u32string const big_endian32{std::endian::native == std::endian::big ? c.utf32
+                                                                             : byteswapped(c.utf32)};
+  std::u32string_view const be32{big_endian32};
+  run("from_big_endian|to_utf8/utf32be" + suffix, c.utf32.size() * sizeof(char32_t),
+      [be32] { return consume(be32 | from_big_endian | to_utf8); });
+}
+
+// from_bom over UTF-8 without a mark, as char8_t and as char, and over
+// UTF-16LE after its mark, to compare with the to_utf16/utf8 and
+// to_utf8/utf16 rows over the same code units. from_bom's iterator
+// dispatches on the encoding for every element; the from_bom(f) rows pass a
+// function the view of the encoding instead, which dispatches once.
+void bench_from_bom(runner const& run, corpus const& c) {
+  std::string const suffix{std::string{"/"} + c.name};
+  std::u8string_view const utf8{c.utf8};
+  run("from_bom<utf16>/utf8" + suffix, utf8.size(), [utf8] { return consume(utf8 | from_bom<char16_t>); });
+  std::string const chars(c.utf8.begin(), c.utf8.end());
+  std::string_view const char_input{chars};
+  run("from_bom<utf16>/utf8,char" + suffix, chars.size(),
+      [char_input] { return consume(char_input | from_bom<char16_t>); });
+  run("from_bom(f)<utf16>/utf8,char" + suffix, chars.size(),
+      [char_input] { return from_bom<char16_t>(char_input, [](auto const& v) { return consume(v); }); });
+
+  std::vector<unsigned char> utf16le{0xFF, 0xFE};
+  for (char16_t const unit : c.utf16) {
+    utf16le.push_back(static_cast<unsigned char>(unit));
+    utf16le.push_back(static_cast<unsigned char>(unit >> 8));
+  }
+  run("from_bom<utf8>/utf16le" + suffix, utf16le.size(), [&utf16le] { return consume(utf16le | from_bom<char8_t>); });
+  run("from_bom(f)<utf8>/utf16le" + suffix, utf16le.size(),
+      [&utf16le] { return from_bom<char8_t>(utf16le, [](auto const& v) { return consume(v); }); });
+}
+
+// Counting the code points of a to_utf32 view by iterating over it, and with
+// utf_distance.
+template <class FromType>
+void bench_distance(runner const& run, corpus const& c) {
+  std::basic_string_view<FromType> const input{c.units<FromType>()};
+  std::size_t const bytes{input.size() * sizeof(FromType)};
+  std::string const suffix{std::string{"/"} + encoding_name<FromType>() + "/" + c.name};
+  run("distance|to_utf32" + suffix, bytes,
+      [input] { return static_cast<std::uint32_t>(std::ranges::distance(input | to_utf32)); });
+  run("utf_distance|to_utf32" + suffix, bytes,
+      [input] { return static_cast<std::uint32_t>(utf_distance(input | to_utf32)); });
+}
+
+// Collecting a to_utf8 view into a std::u8string, with std::ranges::to, which
+// reserves to_utf_view's reserve_hint where the standard library supports it,
+// and by hand after reserving the size of the input, as a reserve hint that
+// passes the base's through would, or the sampled estimate. Reserving too
+// little costs the reallocations that follow.
+template <class FromType>
+void bench_reserve(runner const& run, corpus const& c) {
+  std::basic_string_view<FromType> const input{c.units<FromType>()};
+  std::size_t const bytes{input.size() * sizeof(FromType)};
+  std::string const suffix{std::string{"/"} + encoding_name<FromType>() + "/" + c.name};
+  auto const append{[input](std::size_t reserved) {
+    std::u8string out;
+    out.reserve(reserved);
+    for (char8_t const c : input | to_utf8) {
+      out.push_back(c);
+    }
+    return static_cast<std::uint32_t>(out.size());
+  }};
+  run("to<u8string>|to_utf8" + suffix, bytes,
+      [input] { return static_cast<std::uint32_t>((input | to_utf8 | std::ranges::to<std::u8string>()).size()); });
+  run("reserve(size)+push_back|to_utf8" + suffix, bytes, [input, append] { return append(input.size()); });
+  run("reserve(estimate)+push_back|to_utf8" + suffix, bytes, [input, append] {
+    return append(detail::estimated_transcoded_size<char8_t>(input.data(), input.size()));
+  });
+}
+
+// The two UTF-8 decoders head to head, independent of which one
+// BEMAN_UTF_VIEW_UTF8_DFA_DECODER selects for the views.
+void bench_decoders(runner const& run, corpus const& c) {
+  std::u8string_view const input{c.utf8};
+  auto const decode_all{[input](auto decode) {
+    std::uint32_t sum{};
+    for (auto it = input.begin(); it != input.end();) {
+      sum += decode(it, input.end()).c;
+    }
+    return sum;
+  }};
+  run(std::string{"decode_utf8_cascade/"} + c.name, input.size(), [decode_all] {
+    return decode_all([](auto& it, auto last) { return detail::decode_code_point_utf8_cascade_impl(it, last); });
+  });
+  run(std::string{"decode_utf8_dfa/"} + c.name, input.size(), [decode_all] {
+    return decode_all([](auto& it, auto last) { return detail::decode_code_point_utf8_dfa_impl(it, last); });
+  });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  runner const run{argc > 1 ? argv[1] : ""};
+  std::vector<corpus> const corpora{make_corpora()};
+  std::printf("%-52s %8s\n", "benchmark", "GiB/s");
+  for (corpus const& c : corpora) {
+    bench_from<char8_t>(run, c);
+    bench_from<char16_t>(run, c);
+    bench_from<char32_t>(run, c);
+    bench_adaptors(run, c);
+    bench_from_bom(run, c);
+    bench_distance<char8_t>(run, c);
+    bench_distance<char16_t>(run, c);
+    bench_reserve<char16_t>(run, c);
+    bench_reserve<char32_t>(run, c);
+    bench_decoders(run, c);
+  }
+}
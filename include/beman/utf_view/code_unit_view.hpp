@@ -20,8 +20,10 @@ import beman.utf_view;
 #include <beman/utf_view/detail/concepts.hpp>
 #if !BEMAN_UTF_VIEW_USE_MODULES()
 #include <beman/transform_view/transform_view.hpp>
+#include <concepts>
 #include <ranges>
 #include <type_traits>
+#include <utility>
 #endif
 
 namespace beman::utf_view {
@@ -45,6 +47,26 @@ struct exposition_only_implicit_cast_to {
 
 namespace detail {
 
+  template <class T>
+  inline constexpr bool is_code_unit_cast_view_v = false;
+
+  template <class V, class Char>
+  inline constexpr bool is_code_unit_cast_view_v<
+      beman::transform_view::transform_view<V, exposition_only_implicit_cast_to<Char>>> = true;
+
+  // as_char8_t and the like over contiguous integers of the same size as
+  // their code units, each of which converts to the code unit with the same
+  // object representation. The algorithms that want contiguous code units
+  // copy these a block at a time rather than reading them one at a time
+  // through the view.
+  template <class S>
+  concept contiguous_code_unit_cast_view = is_code_unit_cast_view_v<std::remove_cv_t<S>> &&
+      std::ranges::contiguous_range<decltype(std::declval<S const&>().base())> &&
+      std::ranges::sized_range<decltype(std::declval<S const&>().base())> &&
+      std::integral<std::ranges::range_value_t<decltype(std::declval<S const&>().base())>> &&
+      sizeof(std::ranges::range_value_t<decltype(std::declval<S const&>().base())>) ==
+          sizeof(std::ranges::range_value_t<S>);
+
   template <typename Char>
   struct as_code_unit_impl
       : std::ranges::range_adaptor_closure<as_code_unit_impl<Char>> {
@@ -55,6 +77,13 @@ namespace detail {
       using T = std::remove_cvref_t<R>;
       if constexpr (detail::is_empty_view<T>) {
         return std::ranges::empty_view<Char>{};
+      } else if constexpr (std::same_as<std::ranges::range_value_t<R>, Char> &&
+                           std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<R>>, Char> &&
+                           std::ranges::viewable_range<R>) {
+        // The elements are code units of type Char already, so leave the
+        // range as it is, contiguous if it was, but read-only, as the
+        // elements of the casting view are.
+        return std::views::as_const(std::forward<R>(r));
       } else {
         return beman::transform_view::transform_view(
             std::forward<R>(r), exposition_only_implicit_cast_to<Char>{});
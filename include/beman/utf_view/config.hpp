@@ -8,6 +8,7 @@
 #include <beman/utf_view/config_generated.hpp>
 #else
 #define BEMAN_UTF_VIEW_USE_MODULES() 0
+#define BEMAN_UTF_VIEW_UTF8_DFA_DECODER() 0
 #endif
 
 #endif
@@ -0,0 +1,1028 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_SIMD_HPP
+#define BEMAN_UTF_VIEW_SIMD_HPP
+
+#include <beman/utf_view/config.hpp>
+
+// On x86-64 the vector kernels are compiled for each instruction set
+// regardless of the target of the including translation unit, and the one to
+// use is chosen at run time from what the CPU supports.
+#if defined(__x86_64__) || defined(_M_X64)
+#define BEMAN_UTF_VIEW_DETAIL_SIMD_X86() 1
+#else
+#define BEMAN_UTF_VIEW_DETAIL_SIMD_X86() 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET(isa) [[gnu::target(isa)]]
+#else
+#define BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET(isa)
+#endif
+
+#define BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_SSE42() BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET("sse4.2,popcnt")
+#define BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX2() BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET("avx2,popcnt")
+#define BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX512() \
+  BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET("avx512f,avx512bw,popcnt")
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#if BEMAN_UTF_VIEW_DETAIL_SIMD_X86()
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+#endif
+
+namespace beman::utf_view::detail {
+
+// Vectorized UTF-8 validation after Keiser and Lemire, "Validating UTF-8 In
+// Less Than One Instruction Per Byte" (2021). Each byte is classified by
+// three 16-entry lookups on the high and low nibbles of its predecessor and
+// the high nibble of itself; the bitwise AND of the lookups is nonzero exactly
+// where a two-byte pattern is ill-formed. Three- and four-byte sequences are
+// then checked for having the right number of continuation bytes.
+//
+// The kernels only locate a well-formed prefix; the exact position and kind
+// of an error are always determined by the scalar decoder, so both paths
+// report the same thing.
+
+namespace utf8_lookup {
+
+  inline constexpr std::uint8_t too_short = 1 << 0;
+  inline constexpr std::uint8_t too_long = 1 << 1;
+  inline constexpr std::uint8_t overlong_3 = 1 << 2;
+  inline constexpr std::uint8_t too_large = 1 << 3;
+  inline constexpr std::uint8_t surrogate = 1 << 4;
+  inline constexpr std::uint8_t overlong_2 = 1 << 5;
+  inline constexpr std::uint8_t too_large_1000 = 1 << 6;
+  inline constexpr std::uint8_t overlong_4 = 1 << 6;
+  inline constexpr std::uint8_t two_conts = 1 << 7;
+  inline constexpr std::uint8_t carry = too_short | too_long | two_conts;
+
+  alignas(16) inline constexpr std::uint8_t byte_1_high[16]{
+      // 0_______ ________ <ASCII in byte 1>
+      too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+      // 10______ ________ <continuation in byte 1>
+      two_conts, two_conts, two_conts, two_conts,
+      // 1100____ ________ <two byte lead in byte 1>
+      too_short | overlong_2,
+      // 1101____ ________ <two byte lead in byte 1>
+      too_short,
+      // 1110____ ________ <three byte lead in byte 1>
+      too_short | overlong_3 | surrogate,
+      // 1111____ ________ <four+ byte lead in byte 1>
+      too_short | too_large | too_large_1000 | overlong_4};
+
+  alignas(16) inline constexpr std::uint8_t byte_1_low[16]{
+      // ____0000 ________
+      carry | overlong_3 | overlong_2 | overlong_4,
+      // ____0001 ________
+      carry | overlong_2,
+      // ____001_ ________
+      carry, carry,
+      // ____0100 ________
+      carry | too_large,
+      // ____0101 ________
+      carry | too_large | too_large_1000,
+      // ____011_ ________
+      carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+      // ____1___ ________
+      carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+      carry | too_large | too_large_1000, carry | too_large | too_large_1000,
+      carry | too_large | too_large_1000,
+      // ____1101 ________
+      carry | too_large | too_large_1000 | surrogate,
+      carry | too_large | too_large_1000, carry | too_large | too_large_1000};
+
+  alignas(16) inline constexpr std::uint8_t byte_2_high[16]{
+      // ________ 0_______ <ASCII in byte 2>
+      too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+      // ________ 1000____
+      too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+      // ________ 1001____
+      too_long | overlong_2 | two_conts | overlong_3 | too_large,
+      // ________ 101_____
+      too_long | overlong_2 | two_conts | surrogate | too_large,
+      too_long | overlong_2 | two_conts | surrogate | too_large,
+      // ________ 11______
+      too_short, too_short, too_short, too_short};
+
+  // A lead byte this close to the end of a block needs continuation bytes
+  // from the next one. Narrower kernels use the last 16 or 32 entries.
+  alignas(64) inline constexpr std::uint8_t incomplete_max[64]{
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1};
+
+} // namespace utf8_lookup
+
+// Given that [first, p) was accepted by a kernel except that a multi-byte
+// sequence may straddle p, return the start of that sequence, or p.
+inline char8_t const* utf8_boundary_before(char8_t const* first, char8_t const* p) {
+  char8_t const* const lowest = p - std::min<std::ptrdiff_t>(p - first, 3);
+  for (char8_t const* it = p; it != lowest;) {
+    --it;
+    std::uint8_t const u = *it;
+    if (u < 0x80) {
+      break;
+    }
+    if (0xC0 <= u) {
+      std::ptrdiff_t const length = u < 0xE0 ? 2 : u < 0xF0 ? 3 : 4;
+      return p - it < length ? it : p;
+    }
+  }
+  return p;
+}
+
+struct utf8_counts {
+  std::size_t code_points;
+  std::size_t four_byte_sequences;
+};
+
+struct utf16_counts {
+  std::size_t above_7f;
+  std::size_t above_7ff;
+  std::size_t surrogate_pairs;
+};
+
+// The portable kernels, which are also the constant evaluation paths. They
+// use 64-bit words where that does not get in the way of constexpr.
+
+constexpr std::size_t ascii_prefix_length_scalar(char8_t const* first, char8_t const* last) {
+  char8_t const* p = first;
+  if !consteval {
+    for (; last - p >= 8; p += 8) {
+      std::uint64_t word;
+      std::memcpy(&word, p, sizeof(word));
+      word &= 0x8080808080808080;
+      if (word) {
+        int const bit{std::endian::native == std::endian::little ? std::countr_zero(word)
+                                                                   : std::countl_zero(word)};
+        return static_cast<std::size_t>(p - first) + static_cast<std::size_t>(bit / 8);
+      }
+    }
+  }
+  while (p != last && *p < 0x80) {
+    ++p;
+  }
+  return static_cast<std::size_t>(p - first);
+}
+
+// Without vector instructions, only ASCII is skipped ahead of the decoder.
+constexpr char8_t const* utf8_valid_prefix_scalar(char8_t const* first, char8_t const* last) {
+  return first + ascii_prefix_length_scalar(first, last);
+}
+
+// Well-formed UTF-16 up to the first surrogate that is not part of a pair,
+// checked one code unit at a time.
+constexpr char16_t const* utf16_valid_prefix_scalar(char16_t const* first, char16_t const* last) {
+  while (first != last) {
+    std::uint32_t const unit = *first;
+    if ((unit & 0xF800) != 0xD800) {
+      ++first;
+    } else if ((unit & 0xFC00) == 0xD800 && last - first >= 2 && (first[1] & 0xFC00) == 0xDC00) {
+      first += 2;
+    } else {
+      break;
+    }
+  }
+  return first;
+}
+
+// Count the code points in well-formed UTF-8 by counting the bytes that are
+// not continuation bytes, and the ones that need surrogate pairs in UTF-16 by
+// counting four-byte lead bytes.
+constexpr utf8_counts count_utf8_scalar(char8_t const* first, char8_t const* last) {
+  utf8_counts counts{};
+  char8_t const* p = first;
+  if !consteval {
+    for (; last - p >= 8; p += 8) {
+      std::uint64_t word;
+      std::memcpy(&word, p, sizeof(word));
+      // Bit 7 of each byte of these is bits 7 and 6, or 7 through 4, of the
+      // corresponding byte of word; shifting never carries into it.
+      std::uint64_t const continuation{word & ~(word << 1) & 0x8080808080808080};
+      std::uint64_t const four_byte_lead{word & (word << 1) & (word << 2) & (word << 3) &
+                                         0x8080808080808080};
+      counts.code_points += 8 - static_cast<std::size_t>(std::popcount(continuation));
+      counts.four_byte_sequences += static_cast<std::size_t>(std::popcount(four_byte_lead));
+    }
+  }
+  for (; p != last; ++p) {
+    counts.code_points += static_cast<std::size_t>((*p & 0xC0) != 0x80);
+    counts.four_byte_sequences += static_cast<std::size_t>(0xF0 <= *p);
+  }
+  return counts;
+}
+
+// Count the code units of well-formed UTF-16 that take more than one or two
+// bytes in UTF-8, and the surrogate pairs, by counting high surrogates.
+constexpr utf16_counts count_utf16_scalar(char16_t const* first, char16_t const* last) {
+  utf16_counts counts{};
+  for (; first != last; ++first) {
+    counts.above_7f += static_cast<std::size_t>(0x7F < *first);
+    counts.above_7ff += static_cast<std::size_t>(0x7FF < *first);
+    counts.surrogate_pairs += static_cast<std::size_t>((*first & 0xFC00) == 0xD800);
+  }
+  return counts;
+}
+
+constexpr utf8_counts operator+(utf8_counts x, utf8_counts y) {
+  return {.code_points = x.code_points + y.code_points,
+          .four_byte_sequences = x.four_byte_sequences + y.four_byte_sequences};
+}
+
+constexpr utf16_counts operator+(utf16_counts x, utf16_counts y) {
+  return {.above_7f = x.above_7f + y.above_7f,
+          .above_7ff = x.above_7ff + y.above_7ff,
+          .surrogate_pairs = x.surrogate_pairs + y.surrogate_pairs};
+}
+
+// Reverse the bytes of each of the size Width-byte integers at first, and
+// write them to out, which may be first but must not otherwise overlap it.
+// The vector kernels below do the same with a byte shuffle.
+template <std::size_t Width>
+inline void byteswap_copy_scalar(void const* first, std::size_t size, void* out) {
+  using int_type = std::conditional_t<Width == 2, std::uint16_t, std::uint32_t>;
+  auto const* const in_bytes = static_cast<unsigned char const*>(first);
+  auto* const out_bytes = static_cast<unsigned char*>(out);
+  for (std::size_t i = 0; i != size; ++i) {
+    int_type x;
+    std::memcpy(&x, in_bytes + i * Width, Width);
+    x = std::byteswap(x);
+    std::memcpy(out_bytes + i * Width, &x, Width);
+  }
+}
+
+// A block of UTF-16 is well-formed if every high surrogate is followed by a
+// low surrogate and vice versa, which is a single comparison of the block
+// against itself shifted by one code unit. Each of the kernels below checks
+// whole blocks and leaves the rest to the scalar one.
+
+#if BEMAN_UTF_VIEW_DETAIL_SIMD_X86()
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_SSE42()
+inline __m128i utf8_check_block_sse42(__m128i input, __m128i prev_input) {
+  __m128i const nibble_mask{_mm_set1_epi8(0x0F)};
+  __m128i const prev1{_mm_alignr_epi8(input, prev_input, 15)};
+  __m128i const byte_1_high{_mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<__m128i const*>(utf8_lookup::byte_1_high)),
+      _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble_mask))};
+  __m128i const byte_1_low{_mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<__m128i const*>(utf8_lookup::byte_1_low)),
+      _mm_and_si128(prev1, nibble_mask))};
+  __m128i const byte_2_high{_mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<__m128i const*>(utf8_lookup::byte_2_high)),
+      _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask))};
+  __m128i const special_cases{_mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high)};
+
+  __m128i const prev2{_mm_alignr_epi8(input, prev_input, 14)};
+  __m128i const prev3{_mm_alignr_epi8(input, prev_input, 13)};
+  __m128i const is_third_byte{_mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)))};
+  __m128i const is_fourth_byte{_mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)))};
+  __m128i const must_be_continuation{_mm_and_si128(
+      _mm_or_si128(is_third_byte, is_fourth_byte), _mm_set1_epi8(static_cast<char>(0x80)))};
+  return _mm_xor_si128(must_be_continuation, special_cases);
+}
+
+// Check the next block of input, given the state left by the previous one.
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_SSE42()
+inline bool utf8_check_sse42(__m128i input, __m128i& prev_input, __m128i& prev_incomplete) {
+  __m128i error;
+  if (_mm_movemask_epi8(input) == 0) {
+    error = prev_incomplete;
+    prev_incomplete = _mm_setzero_si128();
+  } else {
+    error = utf8_check_block_sse42(input, prev_input);
+    prev_incomplete = _mm_subs_epu8(
+        input, _mm_load_si128(reinterpret_cast<__m128i const*>(utf8_lookup::incomplete_max + 48)));
+  }
+  prev_input = input;
+  return _mm_testz_si128(error, error) != 0;
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_SSE42()
+inline char8_t const* utf8_valid_prefix_sse42(char8_t const* first, char8_t const* last) {
+  __m128i prev_input{_mm_setzero_si128()};
+  __m128i prev_incomplete{_mm_setzero_si128()};
+  char8_t const* p = first;
+  for (; last - p >= 16; p += 16) {
+    if (!utf8_check_sse42(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p)), prev_input,
+                          prev_incomplete)) {
+      return utf8_boundary_before(first, p);
+    }
+  }
+  alignas(16) char8_t tail[16]{};
+  std::copy(p, last, tail);
+  if (utf8_check_sse42(_mm_load_si128(reinterpret_cast<__m128i const*>(tail)), prev_input,
+                       prev_incomplete) &&
+      _mm_testz_si128(prev_incomplete, prev_incomplete)) {
+    return last;
+  }
+  return utf8_boundary_before(first, p);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_SSE42()
+inline std::size_t ascii_prefix_length_sse42(char8_t const* first, char8_t const* last) {
+  char8_t const* p = first;
+  for (; last - p >= 16; p += 16) {
+    auto const mask{static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))))};
+    if (mask) {
+      return static_cast<std::size_t>(p - first) + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+  }
+  return static_cast<std::size_t>(p - first) + ascii_prefix_length_scalar(p, last);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_SSE42()
+inline char16_t const* utf16_valid_prefix_sse42(char16_t const* first, char16_t const* last) {
+  if (first == last || (*first & 0xFC00) == 0xDC00) {
+    return first;
+  }
+  __m128i const surrogate_mask{_mm_set1_epi16(static_cast<short>(0xFC00))};
+  __m128i const high{_mm_set1_epi16(static_cast<short>(0xD800))};
+  __m128i const low{_mm_set1_epi16(static_cast<short>(0xDC00))};
+  char16_t const* p = first;
+  for (; last - p >= 9; p += 8) {
+    __m128i const units{_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))};
+    __m128i const next{_mm_loadu_si128(reinterpret_cast<__m128i const*>(p + 1))};
+    __m128i const mismatch{_mm_xor_si128(_mm_cmpeq_epi16(_mm_and_si128(units, surrogate_mask), high),
+                                         _mm_cmpeq_epi16(_mm_and_si128(next, surrogate_mask), low))};
+    if (!_mm_testz_si128(mismatch, mismatch)) {
+      break;
+    }
+  }
+  if (p != first && (p[-1] & 0xFC00) == 0xD800) {
+    --p;
+  }
+  return utf16_valid_prefix_scalar(p, last);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_SSE42()
+inline utf8_counts count_utf8_sse42(char8_t const* first, char8_t const* last) {
+  utf8_counts counts{};
+  __m128i const max_continuation{_mm_set1_epi8(static_cast<char>(0xBF))};
+  __m128i const min_four_byte_lead{_mm_set1_epi8(static_cast<char>(0xF0))};
+  for (; last - first >= 16; first += 16) {
+    __m128i const input{_mm_loadu_si128(reinterpret_cast<__m128i const*>(first))};
+    counts.code_points += static_cast<std::size_t>(std::popcount(static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(input, max_continuation)))));
+    counts.four_byte_sequences += static_cast<std::size_t>(
+        std::popcount(static_cast<std::uint32_t>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_max_epu8(input, min_four_byte_lead), input)))));
+  }
+  return counts + count_utf8_scalar(first, last);
+}
+
+// The number of 16-bit lanes set in a comparison result.
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_SSE42()
+inline std::size_t count_lanes_sse42(__m128i mask) {
+  return static_cast<std::size_t>(
+             std::popcount(static_cast<std::uint32_t>(_mm_movemask_epi8(mask)))) /
+      2;
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_SSE42()
+inline utf16_counts count_utf16_sse42(char16_t const* first, char16_t const* last) {
+  utf16_counts counts{};
+  __m128i const zero{_mm_setzero_si128()};
+  for (; last - first >= 8; first += 8) {
+    __m128i const units{_mm_loadu_si128(reinterpret_cast<__m128i const*>(first))};
+    counts.above_7f += 8 - count_lanes_sse42(_mm_cmpeq_epi16(
+        _mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xFF80))), zero));
+    counts.above_7ff += 8 - count_lanes_sse42(_mm_cmpeq_epi16(
+        _mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xF800))), zero));
+    counts.surrogate_pairs += count_lanes_sse42(
+        _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<short>(0xFC00))),
+                        _mm_set1_epi16(static_cast<short>(0xD800))));
+  }
+  return counts + count_utf16_scalar(first, last);
+}
+
+// The pshufb controls that reverse each two- or four-byte lane of a 16-byte
+// block. The wider kernels shuffle within each 128-bit lane, so they
+// broadcast the same control to every lane.
+alignas(16) inline constexpr std::uint8_t byteswap_16_shuffle[16]{1, 0, 3,  2,  5,  4,  7,  6,
+                                                                  9, 8, 11, 10, 13, 12, 15, 14};
+alignas(16) inline constexpr std::uint8_t byteswap_32_shuffle[16]{3,  2,  1,  0,  7,  6,  5,  4,
+                                                                  11, 10, 9,  8,  15, 14, 13, 12};
+
+template <std::size_t Width>
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_SSE42()
+inline __m128i byteswap_shuffle() {
+  return _mm_load_si128(
+      reinterpret_cast<__m128i const*>(Width == 2 ? byteswap_16_shuffle : byteswap_32_shuffle));
+}
+
+template <std::size_t Width>
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_SSE42()
+inline void byteswap_copy_sse42(void const* first, std::size_t size, void* out) {
+  auto const* in_bytes = static_cast<unsigned char const*>(first);
+  auto* out_bytes = static_cast<unsigned char*>(out);
+  __m128i const shuffle{byteswap_shuffle<Width>()};
+  for (; size >= 16 / Width; size -= 16 / Width, in_bytes += 16, out_bytes += 16) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out_bytes),
+                     _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(in_bytes)), shuffle));
+  }
+  byteswap_copy_scalar<Width>(in_bytes, size, out_bytes);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX2()
+inline __m256i utf8_check_block_avx2(__m256i input, __m256i prev_input) {
+  __m256i const nibble_mask{_mm256_set1_epi8(0x0F)};
+  // The high half of prev_input followed by the low half of input, so that
+  // alignr can shift bytes across the lane boundary.
+  __m256i const straddle{_mm256_permute2x128_si256(prev_input, input, 0x21)};
+  __m256i const prev1{_mm256_alignr_epi8(input, straddle, 15)};
+  __m256i const byte_1_high{_mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<__m128i const*>(utf8_lookup::byte_1_high))),
+      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble_mask))};
+  __m256i const byte_1_low{_mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<__m128i const*>(utf8_lookup::byte_1_low))),
+      _mm256_and_si256(prev1, nibble_mask))};
+  __m256i const byte_2_high{_mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<__m128i const*>(utf8_lookup::byte_2_high))),
+      _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask))};
+  __m256i const special_cases{
+      _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high)};
+
+  __m256i const prev2{_mm256_alignr_epi8(input, straddle, 14)};
+  __m256i const prev3{_mm256_alignr_epi8(input, straddle, 13)};
+  __m256i const is_third_byte{
+      _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)))};
+  __m256i const is_fourth_byte{
+      _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)))};
+  __m256i const must_be_continuation{_mm256_and_si256(
+      _mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(static_cast<char>(0x80)))};
+  return _mm256_xor_si256(must_be_continuation, special_cases);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX2()
+inline bool utf8_check_avx2(__m256i input, __m256i& prev_input, __m256i& prev_incomplete) {
+  __m256i error;
+  if (_mm256_movemask_epi8(input) == 0) {
+    error = prev_incomplete;
+    prev_incomplete = _mm256_setzero_si256();
+  } else {
+    error = utf8_check_block_avx2(input, prev_input);
+    prev_incomplete = _mm256_subs_epu8(
+        input, _mm256_load_si256(reinterpret_cast<__m256i const*>(utf8_lookup::incomplete_max + 32)));
+  }
+  prev_input = input;
+  return _mm256_testz_si256(error, error) != 0;
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX2()
+inline char8_t const* utf8_valid_prefix_avx2(char8_t const* first, char8_t const* last) {
+  __m256i prev_input{_mm256_setzero_si256()};
+  __m256i prev_incomplete{_mm256_setzero_si256()};
+  char8_t const* p = first;
+  for (; last - p >= 32; p += 32) {
+    if (!utf8_check_avx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)), prev_input,
+                         prev_incomplete)) {
+      return utf8_boundary_before(first, p);
+    }
+  }
+  alignas(32) char8_t tail[32]{};
+  std::copy(p, last, tail);
+  if (utf8_check_avx2(_mm256_load_si256(reinterpret_cast<__m256i const*>(tail)), prev_input,
+                      prev_incomplete) &&
+      _mm256_testz_si256(prev_incomplete, prev_incomplete)) {
+    return last;
+  }
+  return utf8_boundary_before(first, p);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX2()
+inline std::size_t ascii_prefix_length_avx2(char8_t const* first, char8_t const* last) {
+  char8_t const* p = first;
+  for (; last - p >= 32; p += 32) {
+    auto const mask{static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p))))};
+    if (mask) {
+      return static_cast<std::size_t>(p - first) + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+  }
+  return static_cast<std::size_t>(p - first) + ascii_prefix_length_scalar(p, last);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX2()
+inline char16_t const* utf16_valid_prefix_avx2(char16_t const* first, char16_t const* last) {
+  if (first == last || (*first & 0xFC00) == 0xDC00) {
+    return first;
+  }
+  __m256i const surrogate_mask{_mm256_set1_epi16(static_cast<short>(0xFC00))};
+  __m256i const high{_mm256_set1_epi16(static_cast<short>(0xD800))};
+  __m256i const low{_mm256_set1_epi16(static_cast<short>(0xDC00))};
+  char16_t const* p = first;
+  for (; last - p >= 17; p += 16) {
+    __m256i const units{_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p))};
+    __m256i const next{_mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + 1))};
+    __m256i const mismatch{
+        _mm256_xor_si256(_mm256_cmpeq_epi16(_mm256_and_si256(units, surrogate_mask), high),
+                         _mm256_cmpeq_epi16(_mm256_and_si256(next, surrogate_mask), low))};
+    if (!_mm256_testz_si256(mismatch, mismatch)) {
+      break;
+    }
+  }
+  if (p != first && (p[-1] & 0xFC00) == 0xD800) {
+    --p;
+  }
+  return utf16_valid_prefix_scalar(p, last);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX2()
+inline utf8_counts count_utf8_avx2(char8_t const* first, char8_t const* last) {
+  utf8_counts counts{};
+  __m256i const max_continuation{_mm256_set1_epi8(static_cast<char>(0xBF))};
+  __m256i const min_four_byte_lead{_mm256_set1_epi8(static_cast<char>(0xF0))};
+  for (; last - first >= 32; first += 32) {
+    __m256i const input{_mm256_loadu_si256(reinterpret_cast<__m256i const*>(first))};
+    counts.code_points += static_cast<std::size_t>(std::popcount(static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpgt_epi8(input, max_continuation)))));
+    counts.four_byte_sequences += static_cast<std::size_t>(
+        std::popcount(static_cast<std::uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_max_epu8(input, min_four_byte_lead), input)))));
+  }
+  return counts + count_utf8_scalar(first, last);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX2()
+inline std::size_t count_lanes_avx2(__m256i mask) {
+  return static_cast<std::size_t>(
+             std::popcount(static_cast<std::uint32_t>(_mm256_movemask_epi8(mask)))) /
+      2;
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX2()
+inline utf16_counts count_utf16_avx2(char16_t const* first, char16_t const* last) {
+  utf16_counts counts{};
+  __m256i const zero{_mm256_setzero_si256()};
+  for (; last - first >= 16; first += 16) {
+    __m256i const units{_mm256_loadu_si256(reinterpret_cast<__m256i const*>(first))};
+    counts.above_7f += 16 - count_lanes_avx2(_mm256_cmpeq_epi16(
+        _mm256_and_si256(units, _mm256_set1_epi16(static_cast<short>(0xFF80))), zero));
+    counts.above_7ff += 16 - count_lanes_avx2(_mm256_cmpeq_epi16(
+        _mm256_and_si256(units, _mm256_set1_epi16(static_cast<short>(0xF800))), zero));
+    counts.surrogate_pairs += count_lanes_avx2(_mm256_cmpeq_epi16(
+        _mm256_and_si256(units, _mm256_set1_epi16(static_cast<short>(0xFC00))),
+        _mm256_set1_epi16(static_cast<short>(0xD800))));
+  }
+  return counts + count_utf16_scalar(first, last);
+}
+
+template <std::size_t Width>
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX2()
+inline void byteswap_copy_avx2(void const* first, std::size_t size, void* out) {
+  auto const* in_bytes = static_cast<unsigned char const*>(first);
+  auto* out_bytes = static_cast<unsigned char*>(out);
+  __m256i const shuffle{_mm256_broadcastsi128_si256(byteswap_shuffle<Width>())};
+  for (; size >= 32 / Width; size -= 32 / Width, in_bytes += 32, out_bytes += 32) {
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(out_bytes),
+        _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(in_bytes)), shuffle));
+  }
+  byteswap_copy_sse42<Width>(in_bytes, size, out_bytes);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX512()
+inline __m512i utf8_check_block_avx512(__m512i input, __m512i prev_input) {
+  __m512i const nibble_mask{_mm512_set1_epi8(0x0F)};
+  // Each 128-bit lane of this is the lane before it in input, or the last
+  // lane of prev_input, so that alignr can shift bytes across lanes. Here and
+  // below, the zero-masked forms with a full mask stand in for the unmasked
+  // ones, which trip -Wmaybe-uninitialized in GCC 12's headers.
+  __m512i const straddle{_mm512_maskz_alignr_epi64(0xFF, input, prev_input, 6)};
+  __m512i const prev1{_mm512_alignr_epi8(input, straddle, 15)};
+  __m512i const byte_1_high{_mm512_shuffle_epi8(
+      _mm512_maskz_broadcast_i32x4(
+          0xFFFF, _mm_load_si128(reinterpret_cast<__m128i const*>(utf8_lookup::byte_1_high))),
+      _mm512_and_si512(_mm512_srli_epi16(prev1, 4), nibble_mask))};
+  __m512i const byte_1_low{_mm512_shuffle_epi8(
+      _mm512_maskz_broadcast_i32x4(
+          0xFFFF, _mm_load_si128(reinterpret_cast<__m128i const*>(utf8_lookup::byte_1_low))),
+      _mm512_and_si512(prev1, nibble_mask))};
+  __m512i const byte_2_high{_mm512_shuffle_epi8(
+      _mm512_maskz_broadcast_i32x4(
+          0xFFFF, _mm_load_si128(reinterpret_cast<__m128i const*>(utf8_lookup::byte_2_high))),
+      _mm512_and_si512(_mm512_srli_epi16(input, 4), nibble_mask))};
+  __m512i const special_cases{
+      _mm512_and_si512(_mm512_and_si512(byte_1_high, byte_1_low), byte_2_high)};
+
+  __m512i const prev2{_mm512_alignr_epi8(input, straddle, 14)};
+  __m512i const prev3{_mm512_alignr_epi8(input, straddle, 13)};
+  __m512i const is_third_byte{
+      _mm512_subs_epu8(prev2, _mm512_set1_epi8(static_cast<char>(0xE0 - 0x80)))};
+  __m512i const is_fourth_byte{
+      _mm512_subs_epu8(prev3, _mm512_set1_epi8(static_cast<char>(0xF0 - 0x80)))};
+  __m512i const must_be_continuation{_mm512_and_si512(
+      _mm512_or_si512(is_third_byte, is_fourth_byte), _mm512_set1_epi8(static_cast<char>(0x80)))};
+  return _mm512_xor_si512(must_be_continuation, special_cases);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX512()
+inline bool utf8_check_avx512(__m512i input, __m512i& prev_input, __m512i& prev_incomplete) {
+  __m512i error;
+  if (_mm512_movepi8_mask(input) == 0) {
+    error = prev_incomplete;
+    prev_incomplete = _mm512_setzero_si512();
+  } else {
+    error = utf8_check_block_avx512(input, prev_input);
+    prev_incomplete = _mm512_subs_epu8(input, _mm512_load_si512(utf8_lookup::incomplete_max));
+  }
+  prev_input = input;
+  return _mm512_test_epi8_mask(error, error) == 0;
+}
+
+// The tail is read with a masked load, which never touches the bytes it
+// leaves out, so it needs no copy.
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX512()
+inline char8_t const* utf8_valid_prefix_avx512(char8_t const* first, char8_t const* last) {
+  __m512i prev_input{_mm512_setzero_si512()};
+  __m512i prev_incomplete{_mm512_setzero_si512()};
+  char8_t const* p = first;
+  for (; last - p >= 64; p += 64) {
+    if (!utf8_check_avx512(_mm512_loadu_si512(p), prev_input, prev_incomplete)) {
+      return utf8_boundary_before(first, p);
+    }
+  }
+  __mmask64 const tail_mask{(std::uint64_t{1} << (last - p)) - 1};
+  if (utf8_check_avx512(_mm512_maskz_loadu_epi8(tail_mask, p), prev_input, prev_incomplete) &&
+      _mm512_test_epi8_mask(prev_incomplete, prev_incomplete) == 0) {
+    return last;
+  }
+  return utf8_boundary_before(first, p);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX512()
+inline std::size_t ascii_prefix_length_avx512(char8_t const* first, char8_t const* last) {
+  char8_t const* p = first;
+  for (; last - p >= 64; p += 64) {
+    std::uint64_t const mask{_mm512_movepi8_mask(_mm512_loadu_si512(p))};
+    if (mask) {
+      return static_cast<std::size_t>(p - first) + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+  }
+  return static_cast<std::size_t>(p - first) + ascii_prefix_length_scalar(p, last);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX512()
+inline char16_t const* utf16_valid_prefix_avx512(char16_t const* first, char16_t const* last) {
+  if (first == last || (*first & 0xFC00) == 0xDC00) {
+    return first;
+  }
+  __m512i const surrogate_mask{_mm512_set1_epi16(static_cast<short>(0xFC00))};
+  __m512i const high{_mm512_set1_epi16(static_cast<short>(0xD800))};
+  __m512i const low{_mm512_set1_epi16(static_cast<short>(0xDC00))};
+  char16_t const* p = first;
+  for (; last - p >= 33; p += 32) {
+    __m512i const units{_mm512_loadu_si512(p)};
+    __m512i const next{_mm512_loadu_si512(p + 1)};
+    if (_mm512_cmpeq_epi16_mask(_mm512_and_si512(units, surrogate_mask), high) !=
+        _mm512_cmpeq_epi16_mask(_mm512_and_si512(next, surrogate_mask), low)) {
+      break;
+    }
+  }
+  if (p != first && (p[-1] & 0xFC00) == 0xD800) {
+    --p;
+  }
+  return utf16_valid_prefix_scalar(p, last);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX512()
+inline utf8_counts count_utf8_avx512(char8_t const* first, char8_t const* last) {
+  utf8_counts counts{};
+  __m512i const max_continuation{_mm512_set1_epi8(static_cast<char>(0xBF))};
+  __m512i const min_four_byte_lead{_mm512_set1_epi8(static_cast<char>(0xF0))};
+  for (; last - first >= 64; first += 64) {
+    __m512i const input{_mm512_loadu_si512(first)};
+    counts.code_points += static_cast<std::size_t>(
+        std::popcount(std::uint64_t{_mm512_cmpgt_epi8_mask(input, max_continuation)}));
+    counts.four_byte_sequences += static_cast<std::size_t>(
+        std::popcount(std::uint64_t{_mm512_cmpge_epu8_mask(input, min_four_byte_lead)}));
+  }
+  return counts + count_utf8_scalar(first, last);
+}
+
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX512()
+inline utf16_counts count_utf16_avx512(char16_t const* first, char16_t const* last) {
+  utf16_counts counts{};
+  for (; last - first >= 32; first += 32) {
+    __m512i const units{_mm512_loadu_si512(first)};
+    counts.above_7f += static_cast<std::size_t>(std::popcount(std::uint32_t{
+        _mm512_cmpgt_epu16_mask(units, _mm512_set1_epi16(0x7F))}));
+    counts.above_7ff += static_cast<std::size_t>(std::popcount(std::uint32_t{
+        _mm512_cmpgt_epu16_mask(units, _mm512_set1_epi16(0x7FF))}));
+    counts.surrogate_pairs += static_cast<std::size_t>(std::popcount(std::uint32_t{
+        _mm512_cmpeq_epi16_mask(_mm512_and_si512(units, _mm512_set1_epi16(static_cast<short>(0xFC00))),
+                                _mm512_set1_epi16(static_cast<short>(0xD800)))}));
+  }
+  return counts + count_utf16_scalar(first, last);
+}
+
+// As in utf8_valid_prefix_avx512, the tail is a masked load and store.
+template <std::size_t Width>
+BEMAN_UTF_VIEW_DETAIL_SIMD_TARGET_AVX512()
+inline void byteswap_copy_avx512(void const* first, std::size_t size, void* out) {
+  auto const* in_bytes = static_cast<unsigned char const*>(first);
+  auto* out_bytes = static_cast<unsigned char*>(out);
+  __m512i const shuffle{_mm512_maskz_broadcast_i32x4(0xFFFF, byteswap_shuffle<Width>())};
+  for (; size >= 64 / Width; size -= 64 / Width, in_bytes += 64, out_bytes += 64) {
+    _mm512_storeu_si512(out_bytes, _mm512_shuffle_epi8(_mm512_loadu_si512(in_bytes), shuffle));
+  }
+  __mmask64 const tail_mask{(std::uint64_t{1} << (size * Width)) - 1};
+  _mm512_mask_storeu_epi8(out_bytes, tail_mask,
+                          _mm512_shuffle_epi8(_mm512_maskz_loadu_epi8(tail_mask, in_bytes), shuffle));
+}
+
+#endif
+
+// Run-time kernel selection. The first call to kernels() picks the widest
+// instruction set the CPU and operating system support, capped by the
+// BEMAN_UTF_VIEW_SIMD environment variable if it names a narrower one
+// ("scalar", "sse4.2", "avx2" or "avx512"), and caches the choice.
+
+enum class simd_isa : std::uint8_t { scalar, sse42, avx2, avx512 };
+
+struct kernel_table {
+  simd_isa isa;
+  char8_t const* (*utf8_valid_prefix)(char8_t const*, char8_t const*);
+  std::size_t (*ascii_prefix_length)(char8_t const*, char8_t const*);
+  char16_t const* (*utf16_valid_prefix)(char16_t const*, char16_t const*);
+  utf8_counts (*count_utf8)(char8_t const*, char8_t const*);
+  utf16_counts (*count_utf16)(char16_t const*, char16_t const*);
+  void (*byteswap_16)(void const*, std::size_t, void*);
+  void (*byteswap_32)(void const*, std::size_t, void*);
+};
+
+inline constexpr kernel_table scalar_kernels{simd_isa::scalar,       &utf8_valid_prefix_scalar,
+                                             &ascii_prefix_length_scalar, &utf16_valid_prefix_scalar,
+                                             &count_utf8_scalar,         &count_utf16_scalar,
+                                             &byteswap_copy_scalar<2>,  &byteswap_copy_scalar<4>};
+
+#if BEMAN_UTF_VIEW_DETAIL_SIMD_X86()
+
+inline constexpr kernel_table sse42_kernels{simd_isa::sse42,       &utf8_valid_prefix_sse42,
+                                            &ascii_prefix_length_sse42, &utf16_valid_prefix_sse42,
+                                            &count_utf8_sse42,         &count_utf16_sse42,
+                                            &byteswap_copy_sse42<2>,  &byteswap_copy_sse42<4>};
+
+inline constexpr kernel_table avx2_kernels{simd_isa::avx2,       &utf8_valid_prefix_avx2,
+                                           &ascii_prefix_length_avx2, &utf16_valid_prefix_avx2,
+                                           &count_utf8_avx2,         &count_utf16_avx2,
+                                           &byteswap_copy_avx2<2>,  &byteswap_copy_avx2<4>};
+
+inline constexpr kernel_table avx512_kernels{simd_isa::avx512,       &utf8_valid_prefix_avx512,
+                                             &ascii_prefix_length_avx512, &utf16_valid_prefix_avx512,
+                                             &count_utf8_avx512,         &count_utf16_avx512,
+                                             &byteswap_copy_avx512<2>,  &byteswap_copy_avx512<4>};
+
+inline simd_isa detect_simd_isa() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  int const max_leaf{info[0]};
+  __cpuid(info, 1);
+  bool const sse42{(info[2] & (1 << 20)) && (info[2] & (1 << 23))};
+  bool const osxsave{(info[2] & (1 << 27)) != 0};
+  if (!sse42) {
+    return simd_isa::scalar;
+  }
+  if (!osxsave || max_leaf < 7) {
+    return simd_isa::sse42;
+  }
+  // The operating system must save the YMM, and for AVX-512 the ZMM and
+  // opmask, registers across context switches.
+  unsigned long long const xcr0{_xgetbv(0)};
+  __cpuidex(info, 7, 0);
+  if ((xcr0 & 0x06) != 0x06 || !(info[1] & (1 << 5))) {
+    return simd_isa::sse42;
+  }
+  if ((xcr0 & 0xE6) != 0xE6 || !(info[1] & (1 << 16)) || !(info[1] & (1 << 30))) {
+    return simd_isa::avx2;
+  }
+  return simd_isa::avx512;
+#else
+  __builtin_cpu_init();
+  if (!__builtin_cpu_supports("sse4.2") || !__builtin_cpu_supports("popcnt")) {
+    return simd_isa::scalar;
+  }
+  if (!__builtin_cpu_supports("avx2")) {
+    return simd_isa::sse42;
+  }
+  if (!__builtin_cpu_supports("avx512f") || !__builtin_cpu_supports("avx512bw")) {
+    return simd_isa::avx2;
+  }
+  return simd_isa::avx512;
+#endif
+}
+
+#else
+
+inline simd_isa detect_simd_isa() {
+  return simd_isa::scalar;
+}
+
+#endif
+
+// The widest instruction set the kernels can use on this machine.
+inline simd_isa supported_simd_isa() {
+  static simd_isa const isa{detect_simd_isa()};
+  return isa;
+}
+
+inline kernel_table const& kernels_for(simd_isa isa) {
+#if BEMAN_UTF_VIEW_DETAIL_SIMD_X86()
+  switch (std::min(isa, supported_simd_isa())) {
+  case simd_isa::scalar:
+    break;
+  case simd_isa::sse42:
+    return sse42_kernels;
+  case simd_isa::avx2:
+    return avx2_kernels;
+  case simd_isa::avx512:
+    return avx512_kernels;
+  }
+#endif
+  (void)isa;
+  return scalar_kernels;
+}
+
+inline kernel_table const* select_kernels() {
+  simd_isa isa{supported_simd_isa()};
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+  char const* const requested{std::getenv("BEMAN_UTF_VIEW_SIMD")};
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+  if (requested) {
+    constexpr std::pair<std::string_view, simd_isa> names[]{{"scalar", simd_isa::scalar},
+                                                            {"sse4.2", simd_isa::sse42},
+                                                            {"avx2", simd_isa::avx2},
+                                                            {"avx512", simd_isa::avx512}};
+    for (auto const& [name, named_isa] : names) {
+      if (name == requested) {
+        isa = std::min(isa, named_isa);
+      }
+    }
+  }
+  return &kernels_for(isa);
+}
+
+inline std::atomic<kernel_table const*> active_kernels{nullptr};
+
+// The tables are constants, so a relaxed load is all it takes to use one
+// that another thread selected.
+inline kernel_table const& kernels() {
+  kernel_table const* table{active_kernels.load(std::memory_order_relaxed)};
+  if (!table) [[unlikely]] {
+    table = select_kernels();
+    active_kernels.store(table, std::memory_order_relaxed);
+  }
+  return *table;
+}
+
+// Switch to the kernels for isa, or the widest supported instruction set
+// below it, and return the instruction set switched to. For testing every
+// kernel on one machine.
+inline simd_isa use_simd_isa(simd_isa isa) {
+  kernel_table const& table{kernels_for(isa)};
+  active_kernels.store(&table, std::memory_order_relaxed);
+  return table.isa;
+}
+
+// Return the end of the longest well-formed prefix of [first, last) that the
+// vector kernels can vouch for. This always ends on a code point boundary, but
+// is not necessarily followed by an error: the caller continues from it with
+// the scalar decoder. Without vector support this only skips ASCII.
+constexpr char8_t const* utf8_valid_prefix(char8_t const* first, char8_t const* last) {
+  if !consteval {
+    return kernels().utf8_valid_prefix(first, last);
+  }
+  return utf8_valid_prefix_scalar(first, last);
+}
+
+// Return the number of ASCII bytes at the start of [first, last). Runs are
+// often short, so on x86-64 the first 64 bytes are scanned inline with SSE2,
+// which every x86-64 CPU has, and only longer runs go through the kernels.
+constexpr std::size_t ascii_prefix_length(char8_t const* first, char8_t const* last) {
+  if !consteval {
+#if BEMAN_UTF_VIEW_DETAIL_SIMD_X86()
+    char8_t const* p = first;
+    char8_t const* const inline_last = first + std::min<std::ptrdiff_t>(last - first, 64);
+    for (; inline_last - p >= 16; p += 16) {
+      auto const mask{static_cast<std::uint32_t>(
+          _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))))};
+      if (mask) {
+        return static_cast<std::size_t>(p - first) + static_cast<std::size_t>(std::countr_zero(mask));
+      }
+    }
+    if (last - p < 16) {
+      return static_cast<std::size_t>(p - first) + ascii_prefix_length_scalar(p, last);
+    }
+    return static_cast<std::size_t>(p - first) + kernels().ascii_prefix_length(p, last);
+#endif
+  }
+  return ascii_prefix_length_scalar(first, last);
+}
+
+// The UTF-16 counterpart of utf8_valid_prefix.
+constexpr char16_t const* utf16_valid_prefix(char16_t const* first, char16_t const* last) {
+  if !consteval {
+    return kernels().utf16_valid_prefix(first, last);
+  }
+  return utf16_valid_prefix_scalar(first, last);
+}
+
+// The UTF-32 counterpart of utf8_valid_prefix. Every code unit stands alone,
+// so a plain loop is all there is to it.
+constexpr char32_t const* utf32_valid_prefix(char32_t const* first, char32_t const* last) {
+  while (first != last && (*first < 0xD800 || (0xDFFF < *first && *first <= 0x10FFFF))) {
+    ++first;
+  }
+  return first;
+}
+
+// utf8_valid_prefix, utf16_valid_prefix or utf32_valid_prefix, for code units
+// of type FromType.
+template <class FromType>
+constexpr FromType const* valid_prefix(FromType const* first, FromType const* last) {
+  if constexpr (std::is_same_v<FromType, char8_t>) {
+    return utf8_valid_prefix(first, last);
+  } else if constexpr (std::is_same_v<FromType, char16_t>) {
+    return utf16_valid_prefix(first, last);
+  } else {
+    return utf32_valid_prefix(first, last);
+  }
+}
+
+constexpr utf8_counts count_utf8(char8_t const* first, char8_t const* last) {
+  if !consteval {
+    return kernels().count_utf8(first, last);
+  }
+  return count_utf8_scalar(first, last);
+}
+
+constexpr utf16_counts count_utf16(char16_t const* first, char16_t const* last) {
+  if !consteval {
+    return kernels().count_utf16(first, last);
+  }
+  return count_utf16_scalar(first, last);
+}
+
+// Write each element of [first, last) to out with its bytes reversed, as an
+// integer of the same size. out may be first, to swap in place, but must not
+// otherwise overlap the input.
+template <std::integral T, std::integral U>
+  requires(sizeof(T) == sizeof(U) && (sizeof(T) == 2 || sizeof(T) == 4))
+constexpr U* byteswap_copy(T const* first, T const* last, U* out) {
+  if !consteval {
+    kernel_table const& table{kernels()};
+    (sizeof(T) == 2 ? table.byteswap_16 : table.byteswap_32)(first, static_cast<std::size_t>(last - first), out);
+    return out + (last - first);
+  }
+  for (; first != last; ++first, ++out) {
+    *out = static_cast<U>(std::byteswap(*first));
+  }
+  return out;
+}
+
+} // namespace beman::utf_view::detail
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_SIMD_HPP
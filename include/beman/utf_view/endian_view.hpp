@@ -45,6 +45,16 @@ struct exposition_only_byteswap {
 
 namespace detail {
 
+  // from_big_endian or from_little_endian followed by as_char16_t or
+  // as_char32_t, as one function. to_utf uses a single transform_view with
+  // this in place of the two that those adaptors produce.
+  template <class CharT>
+  struct byteswap_to {
+    constexpr CharT operator()(auto x) const noexcept {
+      return static_cast<CharT>(std::byteswap(x));
+    }
+  };
+
   template <std::endian endianness>
   struct from_to_endian_impl
       : std::ranges::range_adaptor_closure<from_to_endian_impl<endianness>> {
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_FOR_EACH_CHUNK_HPP
+#define BEMAN_UTF_VIEW_FOR_EACH_CHUNK_HPP
+
+#include <beman/utf_view/config.hpp>
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcode.hpp>
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace beman::utf_view {
+
+namespace detail {
+
+  // for_each_chunk for a view whose base can be read directly.
+  template <class V, class F>
+  constexpr void for_each_chunk_of_base(V&& view, F& f) {
+    using view_type = std::remove_cvref_t<V>;
+    using value_type = std::ranges::range_value_t<view_type>;
+    decltype(auto) source = transcode_source(std::forward<V>(view));
+    using S = std::remove_reference_t<decltype(source)>;
+    using from_type = std::remove_cv_t<std::ranges::range_value_t<S>>;
+
+    if constexpr (exposition_only_code_unit<value_type>) {
+      transcode_blocks<to_utf_view_error_kind::replacement, value_type>(
+          source, [&](value_type const* first, value_type const* last) {
+            if (first != last) {
+              std::invoke(f, std::span<value_type const>{first, last});
+            }
+          });
+    } else {
+      using to_type = typename value_type::value_type;
+      value_type buf[transcode_block_size];
+      std::size_t size{};
+      auto const flush{[&] {
+        if (size) {
+          std::invoke(f, std::span<value_type const>{buf, size});
+          size = 0;
+        }
+      }};
+      auto it = std::ranges::begin(source);
+      auto const last = std::ranges::end(source);
+      while (it != last) {
+        if (transcode_block_size - size < max_code_units<to_type>) {
+          flush();
+        }
+        decode_code_point_result const decode_result{decode_code_point_impl<from_type>(it, last)};
+        if (!decode_result.success) {
+          buf[size++] = std::unexpected{decode_result.success.error()};
+          continue;
+        }
+        to_type units[max_code_units<to_type>];
+        to_type const* const units_end{encode_code_point<to_type>(decode_result.c, +units)};
+        for (to_type const* unit = units; unit != units_end; ++unit) {
+          buf[size++] = *unit;
+        }
+      }
+      flush();
+    }
+  }
+
+  // for_each_chunk for an lvalue view whose base cannot be copied out of it,
+  // which collects the view's own elements into blocks.
+  template <class V, class F>
+  constexpr void for_each_chunk_of_elements(V& view, F& f) {
+    using value_type = std::ranges::range_value_t<std::remove_cvref_t<V>>;
+    value_type buf[transcode_block_size];
+    std::size_t size{};
+    for (auto&& element : view) {
+      buf[size++] = element;
+      if (size == transcode_block_size) {
+        std::invoke(f, std::span<value_type const>{buf, size});
+        size = 0;
+      }
+    }
+    if (size) {
+      std::invoke(f, std::span<value_type const>{buf, size});
+    }
+  }
+
+} // namespace detail
+
+// Calls f with consecutive blocks of the elements of view, as
+// std::span<range_value_t<V> const>s, in order. This visits the same elements
+// as iterating over view, but decodes them a block at a time, so consumers
+// that can take a whole span at once, like writers, hashers or append, pay
+// per-block rather than per-code-unit overhead. Empty blocks are never passed.
+//
+// Only to_utf views in replacement mode produce their blocks with the block
+// decoder. Elements of to_utf_or_error views are std::expected values, which
+// are decoded into blocks one code point at a time.
+//
+// An lvalue view whose base is move-only, such as one that owns a string,
+// cannot hand its base over, so its elements are iterated over and collected
+// into blocks instead.
+template <class V, class F>
+  requires detail::is_to_utf_view_v<std::remove_cvref_t<V>> &&
+           std::invocable<F&, std::span<std::ranges::range_value_t<std::remove_cvref_t<V>> const>>
+constexpr F for_each_chunk(V&& view, F f) {
+  if constexpr (requires(V&& v) { std::forward<V>(v).base(); }) {
+    detail::for_each_chunk_of_base(std::forward<V>(view), f);
+  } else {
+    detail::for_each_chunk_of_elements(view, f);
+  }
+  return f;
+}
+
+} // namespace beman::utf_view
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_FOR_EACH_CHUNK_HPP
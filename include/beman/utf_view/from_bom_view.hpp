@@ -0,0 +1,474 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_FROM_BOM_VIEW_HPP
+#define BEMAN_UTF_VIEW_FROM_BOM_VIEW_HPP
+
+#include <beman/utf_view/config.hpp>
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#include <beman/utf_view/code_unit_view.hpp>
+#include <beman/utf_view/detail/concepts.hpp>
+#include <beman/utf_view/detail/constant_wrapper_polyfill.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#endif
+
+namespace beman::utf_view {
+
+// The encodings that a byte order mark distinguishes.
+enum class bom_encoding : unsigned char {
+  utf8,
+  utf16le,
+  utf16be,
+  utf32le,
+  utf32be
+};
+
+struct detected_bom {
+  bom_encoding encoding;
+  std::uint8_t size;
+
+  friend constexpr bool operator==(detected_bom, detected_bom) = default;
+};
+
+namespace detail {
+
+  template <class T>
+  concept byte_like = sizeof(T) == 1 && !std::same_as<std::remove_cv_t<T>, bool> &&
+      (std::integral<T> || std::same_as<std::remove_cv_t<T>, std::byte>);
+
+  template <byte_like T>
+  constexpr std::uint8_t byte_value(T b) noexcept {
+    return static_cast<std::uint8_t>(b);
+  }
+
+  // Code units of type CharT stored as bytes in the byte order Endian. If
+  // the bytes run out partway through the last code unit, it reads as one
+  // that is ill-formed wherever it appears (a high surrogate with nothing
+  // after it, or a value past U+10FFFF), so that it decodes to a single
+  // replacement character.
+  template <class CharT, std::endian Endian, byte_like Byte>
+  class bom_code_unit_iterator {
+    static constexpr std::ptrdiff_t width = sizeof(CharT);
+
+    Byte const* pos_ = nullptr;
+    Byte const* last_ = nullptr;
+    // The number of bytes in a partial last code unit, if there is one.
+    std::uint8_t tail_ = 0;
+
+  public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = CharT;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr bom_code_unit_iterator() = default;
+
+    constexpr bom_code_unit_iterator(Byte const* pos, Byte const* last, std::uint8_t tail)
+        : pos_{pos}, last_{last}, tail_{tail} {}
+
+    constexpr CharT operator*() const {
+      if constexpr (width == 1) {
+        return static_cast<CharT>(byte_value(*pos_));
+      } else {
+        if (last_ - pos_ < width) [[unlikely]] {
+          return static_cast<CharT>(width == 2 ? 0xD800 : 0xFFFFFFFF);
+        }
+        std::uint32_t u{};
+        for (std::ptrdiff_t i = 0; i != width; ++i) {
+          std::ptrdiff_t const shift{Endian == std::endian::little ? i : width - 1 - i};
+          u |= static_cast<std::uint32_t>(byte_value(pos_[i])) << (8 * shift);
+        }
+        return static_cast<CharT>(u);
+      }
+    }
+
+    constexpr CharT operator[](difference_type n) const {
+      return *(*this + n);
+    }
+
+    constexpr bom_code_unit_iterator& operator++() {
+      pos_ += std::min(width, last_ - pos_);
+      return *this;
+    }
+
+    constexpr bom_code_unit_iterator operator++(int) {
+      auto retval = *this;
+      ++*this;
+      return retval;
+    }
+
+    constexpr bom_code_unit_iterator& operator--() {
+      pos_ -= pos_ == last_ && tail_ != 0 ? tail_ : width;
+      return *this;
+    }
+
+    constexpr bom_code_unit_iterator operator--(int) {
+      auto retval = *this;
+      --*this;
+      return retval;
+    }
+
+    constexpr bom_code_unit_iterator& operator+=(difference_type n) {
+      if (0 < n) {
+        pos_ += std::min(n * width, last_ - pos_);
+      } else if (n < 0) {
+        if (pos_ == last_ && tail_ != 0) {
+          pos_ -= tail_;
+          ++n;
+        }
+        pos_ += n * width;
+      }
+      return *this;
+    }
+
+    constexpr bom_code_unit_iterator& operator-=(difference_type n) {
+      return *this += -n;
+    }
+
+    friend constexpr bom_code_unit_iterator operator+(bom_code_unit_iterator it, difference_type n) {
+      it += n;
+      return it;
+    }
+
+    friend constexpr bom_code_unit_iterator operator+(difference_type n, bom_code_unit_iterator it) {
+      it += n;
+      return it;
+    }
+
+    friend constexpr bom_code_unit_iterator operator-(bom_code_unit_iterator it, difference_type n) {
+      it -= n;
+      return it;
+    }
+
+    // Positions other than the end are a whole number of code units apart,
+    // and the end is a partial code unit past the last of them.
+    friend constexpr difference_type operator-(bom_code_unit_iterator const& x, bom_code_unit_iterator const& y) {
+      difference_type const bytes{x.pos_ - y.pos_};
+      return bytes < 0 ? -((width - 1 - bytes) / width) : (bytes + width - 1) / width;
+    }
+
+    friend constexpr bool operator==(bom_code_unit_iterator const& x, bom_code_unit_iterator const& y) {
+      return x.pos_ == y.pos_;
+    }
+
+    friend constexpr std::strong_ordering operator<=>(bom_code_unit_iterator const& x,
+                                                      bom_code_unit_iterator const& y) {
+      return x.pos_ <=> y.pos_;
+    }
+  };
+
+  template <class CharT, std::endian Endian, class Byte>
+  using bom_code_units = std::ranges::subrange<bom_code_unit_iterator<CharT, Endian, Byte>>;
+
+  // The code units in the bytes [first, last).
+  template <class CharT, std::endian Endian, byte_like Byte>
+  constexpr bom_code_units<CharT, Endian, Byte> bom_code_units_of(Byte const* first, Byte const* last) {
+    using unit_iterator = bom_code_unit_iterator<CharT, Endian, Byte>;
+    auto const tail{static_cast<std::uint8_t>(static_cast<std::size_t>(last - first) % sizeof(CharT))};
+    return {unit_iterator{first, last, tail}, unit_iterator{last, last, tail}};
+  }
+
+} // namespace detail
+
+// The encoding of bytes that start with a UTF-8, UTF-16, or UTF-32 byte order
+// mark, and the length of the mark, or UTF-8 and 0 if there is none. FF FE
+// 00 00 is taken to be the UTF-32LE mark rather than the UTF-16LE one
+// followed by U+0000.
+template <std::ranges::contiguous_range R>
+  requires std::ranges::sized_range<R> && detail::byte_like<std::ranges::range_value_t<R>>
+constexpr detected_bom detect_bom(R&& bytes) {
+  auto const* const data = std::ranges::data(bytes);
+  std::size_t const size{std::ranges::size(bytes)};
+  auto const starts_with{[&](std::initializer_list<std::uint8_t> mark) {
+    return mark.size() <= size &&
+        std::ranges::equal(mark, std::ranges::subrange(data, data + mark.size()), {}, {},
+                           [](auto b) { return detail::byte_value(b); });
+  }};
+  if (starts_with({0xEF, 0xBB, 0xBF})) {
+    return {.encoding = bom_encoding::utf8, .size = 3};
+  } else if (starts_with({0xFF, 0xFE, 0x00, 0x00})) {
+    return {.encoding = bom_encoding::utf32le, .size = 4};
+  } else if (starts_with({0x00, 0x00, 0xFE, 0xFF})) {
+    return {.encoding = bom_encoding::utf32be, .size = 4};
+  } else if (starts_with({0xFF, 0xFE})) {
+    return {.encoding = bom_encoding::utf16le, .size = 2};
+  } else if (starts_with({0xFE, 0xFF})) {
+    return {.encoding = bom_encoding::utf16be, .size = 2};
+  }
+  return {.encoding = bom_encoding::utf8, .size = 0};
+}
+
+// A view of bytes in whichever encoding their byte order mark says, or UTF-8
+// if there is none, transcoded to ToType with the mark left out. The choice
+// is made once, when the view is constructed, so the view has the same type
+// whatever the encoding turns out to be; its iterators hold an iterator of
+// the to_utf_view that the encoding calls for, and produce the same elements
+// it would, errors included. A partial code unit at the end of UTF-16 or
+// UTF-32 is one more ill-formed subsequence, reported as an unpaired high
+// surrogate or an out of range code point respectively.
+//
+// That iterator is one of five alternatives of a std::variant, so every
+// dereference, increment and decrement dispatches on the encoding, and
+// costs more than it would through the to_utf_view itself. UTF-8 in bytes
+// of type char8_t is decoded from a std::span of them, which keeps
+// to_utf_view's contiguous fast paths. Other code units are read a byte at
+// a time through bom_code_unit_iterator, which does not. Passing a function
+// to from_bom as well as the bytes avoids both costs where it can; see
+// below.
+template <std::ranges::view V, to_utf_view_error_kind E, exposition_only_code_unit ToType>
+  requires std::ranges::contiguous_range<V const> && std::ranges::sized_range<V const> &&
+           detail::byte_like<std::ranges::range_value_t<V>>
+class from_bom_view : public std::ranges::view_interface<from_bom_view<V, E, ToType>> {
+  using byte_type = std::remove_cv_t<std::ranges::range_value_t<V>>;
+
+  // Whether code units of type CharT are the bytes themselves, and so are
+  // read from a std::span of them rather than through bom_code_units.
+  template <class CharT>
+  static constexpr bool contiguous_units = std::same_as<CharT, char8_t> && std::same_as<byte_type, char8_t>;
+
+  template <class CharT, std::endian Endian>
+  using code_units_from = std::conditional_t<contiguous_units<CharT>, std::span<char8_t const>,
+                                             detail::bom_code_units<CharT, Endian, byte_type>>;
+
+  template <class CharT, std::endian Endian>
+  using to_utf_view_from = to_utf_view<code_units_from<CharT, Endian>, E, ToType>;
+
+  template <class CharT, std::endian Endian>
+  using to_utf_iterator_from = std::ranges::iterator_t<to_utf_view_from<CharT, Endian>>;
+
+  V base_ = V();
+  detected_bom bom_{};
+
+public:
+  class iterator {
+    // In the same order as bom_encoding.
+    std::variant<to_utf_iterator_from<char8_t, std::endian::little>,
+                 to_utf_iterator_from<char16_t, std::endian::little>,
+                 to_utf_iterator_from<char16_t, std::endian::big>,
+                 to_utf_iterator_from<char32_t, std::endian::little>,
+                 to_utf_iterator_from<char32_t, std::endian::big>>
+        it_;
+
+    friend class from_bom_view;
+
+    template <class It>
+    constexpr explicit iterator(It it) : it_{std::move(it)} {}
+
+  public:
+    using iterator_concept = std::bidirectional_iterator_tag;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::iter_value_t<to_utf_iterator_from<char8_t, std::endian::little>>;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr iterator() = default;
+
+    constexpr value_type operator*() const {
+      return std::visit([](auto const& it) -> value_type { return *it; }, it_);
+    }
+
+    constexpr iterator& operator++() {
+      std::visit([](auto& it) { ++it; }, it_);
+      return *this;
+    }
+
+    constexpr iterator operator++(int) {
+      auto retval = *this;
+      ++*this;
+      return retval;
+    }
+
+    constexpr iterator& operator--() {
+      std::visit([](auto& it) { --it; }, it_);
+      return *this;
+    }
+
+    constexpr iterator operator--(int) {
+      auto retval = *this;
+      --*this;
+      return retval;
+    }
+
+    friend constexpr bool operator==(iterator const& x, iterator const& y) {
+      return x.it_ == y.it_;
+    }
+  };
+
+private:
+  // An iterator at the start or the end of the code units after the mark.
+  template <class CharT, std::endian Endian>
+  constexpr iterator make_iterator(bool at_end) const {
+    auto const* const first = std::ranges::data(base_) + bom_.size;
+    auto const* const last = std::ranges::data(base_) + std::ranges::size(base_);
+    code_units_from<CharT, Endian> units;
+    if constexpr (contiguous_units<CharT>) {
+      units = std::span<char8_t const>{first, last};
+    } else {
+      units = detail::bom_code_units_of<CharT, Endian>(first, last);
+    }
+    to_utf_view_from<CharT, Endian> view{std::move(units), detail::cw<E>, to_utf_tag<ToType>};
+    return iterator{at_end ? view.end() : view.begin()};
+  }
+
+  constexpr iterator make_iterator(bool at_end) const {
+    switch (bom_.encoding) {
+    case bom_encoding::utf16le:
+      return make_iterator<char16_t, std::endian::little>(at_end);
+    case bom_encoding::utf16be:
+      return make_iterator<char16_t, std::endian::big>(at_end);
+    case bom_encoding::utf32le:
+      return make_iterator<char32_t, std::endian::little>(at_end);
+    case bom_encoding::utf32be:
+      return make_iterator<char32_t, std::endian::big>(at_end);
+    default:
+      return make_iterator<char8_t, std::endian::little>(at_end);
+    }
+  }
+
+public:
+  constexpr from_bom_view()
+    requires std::default_initializable<V>
+  = default;
+
+  constexpr explicit from_bom_view(V base) : base_{std::move(base)}, bom_{detect_bom(std::as_const(base_))} {}
+
+  constexpr V base() const&
+    requires std::copy_constructible<V>
+  {
+    return base_;
+  }
+
+  constexpr V base() && {
+    return std::move(base_);
+  }
+
+  // The encoding the bytes were found to be in.
+  constexpr bom_encoding encoding() const noexcept {
+    return bom_.encoding;
+  }
+
+  // The length of the byte order mark, or 0 if there was none.
+  constexpr std::size_t bom_size() const noexcept {
+    return bom_.size;
+  }
+
+  constexpr iterator begin() const {
+    return make_iterator(false);
+  }
+
+  constexpr iterator end() const {
+    return make_iterator(true);
+  }
+
+  constexpr bool empty() const {
+    return std::ranges::size(base_) == bom_.size;
+  }
+};
+
+namespace detail {
+
+  // Calls f with a to_utf_view of the code units of type CharT in the bytes
+  // [first, last), stored in the byte order Endian. UTF-8 in bytes that are
+  // integers is read through as_char8_t, and std::byte is read as unsigned
+  // char, which may alias it, so that to_utf_view copies a block of them at
+  // a time into code units rather than reading them one at a time.
+  template <class CharT, std::endian Endian, to_utf_view_error_kind E, exposition_only_code_unit ToType,
+            byte_like Byte, class F>
+  constexpr decltype(auto) invoke_with_to_utf_view(Byte const* first, Byte const* last, F& f) {
+    auto const invoke_with{[&f]<class Units>(Units units) -> decltype(auto) {
+      return std::invoke(f, to_utf_view<Units, E, ToType>{std::move(units), cw<E>, to_utf_tag<ToType>});
+    }};
+    if constexpr (!std::same_as<CharT, char8_t>) {
+      return invoke_with(bom_code_units_of<CharT, Endian>(first, last));
+    } else if constexpr (std::same_as<Byte, char8_t>) {
+      return invoke_with(std::span<char8_t const>{first, last});
+    } else if constexpr (std::integral<Byte>) {
+      return invoke_with(std::span<Byte const>{first, last} | as_char8_t);
+    } else {
+      if !consteval {
+        auto const* const data = reinterpret_cast<unsigned char const*>(first);
+        return invoke_with(std::span<unsigned char const>{data, data + (last - first)} | as_char8_t);
+      }
+      return invoke_with(bom_code_units_of<char8_t, Endian>(first, last));
+    }
+  }
+
+  template <to_utf_view_error_kind E, exposition_only_code_unit ToType>
+  struct from_bom_impl : std::ranges::range_adaptor_closure<from_bom_impl<E, ToType>> {
+    template <std::ranges::viewable_range R>
+      requires std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+               byte_like<std::ranges::range_value_t<R>> && is_not_array_of_char<R>
+    constexpr auto operator()(R&& r) const {
+      return from_bom_view<std::views::all_t<R>, E, ToType>(std::views::all(std::forward<R>(r)));
+    }
+
+    // Calls f with the to_utf_view of the code units after the byte order
+    // mark of r, if any, that from_bom_view would iterate through, and
+    // returns what f returns. The encoding is dispatched on once, here,
+    // rather than at every step of the iteration, so f is called with one of
+    // several view types and, as with std::visit, must return the same type
+    // for each of them. The view refers to r and must not outlive it.
+    template <std::ranges::contiguous_range R, class F>
+      requires std::ranges::sized_range<R> && byte_like<std::ranges::range_value_t<R>> && is_not_array_of_char<R>
+    constexpr decltype(auto) operator()(R&& r, F&& f) const {
+      auto const* const first = std::ranges::data(r);
+      auto const* const last = first + std::ranges::size(r);
+      detected_bom const bom{detect_bom(r)};
+      switch (bom.encoding) {
+      case bom_encoding::utf16le:
+        return invoke_with_to_utf_view<char16_t, std::endian::little, E, ToType>(first + bom.size, last, f);
+      case bom_encoding::utf16be:
+        return invoke_with_to_utf_view<char16_t, std::endian::big, E, ToType>(first + bom.size, last, f);
+      case bom_encoding::utf32le:
+        return invoke_with_to_utf_view<char32_t, std::endian::little, E, ToType>(first + bom.size, last, f);
+      case bom_encoding::utf32be:
+        return invoke_with_to_utf_view<char32_t, std::endian::big, E, ToType>(first + bom.size, last, f);
+      default:
+        return invoke_with_to_utf_view<char8_t, std::endian::little, E, ToType>(first + bom.size, last, f);
+      }
+    }
+  };
+
+} // namespace detail
+
+template <exposition_only_code_unit ToType>
+inline constexpr detail::from_bom_impl<to_utf_view_error_kind::replacement, ToType> from_bom;
+
+template <exposition_only_code_unit ToType>
+inline constexpr detail::from_bom_impl<to_utf_view_error_kind::expected, ToType> from_bom_or_error;
+
+} // namespace beman::utf_view
+
+template <class V, beman::utf_view::to_utf_view_error_kind E, class ToType>
+inline constexpr bool std::ranges::enable_borrowed_range<beman::utf_view::from_bom_view<V, E, ToType>> =
+    std::ranges::enable_borrowed_range<V>;
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_FROM_BOM_VIEW_HPP
@@ -0,0 +1,377 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_INDEXED_UTF_VIEW_HPP
+#define BEMAN_UTF_VIEW_INDEXED_UTF_VIEW_HPP
+
+#include <beman/utf_view/config.hpp>
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#include <beman/utf_view/detail/concepts.hpp>
+#include <beman/utf_view/detail/simd.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+
+namespace beman::utf_view {
+
+namespace detail {
+
+  // The number of code points between the checkpoints that indexed_utf_view
+  // records, and so the most it decodes to reach any position.
+  inline constexpr std::size_t code_point_index_stride = 128;
+
+  struct code_point_index {
+    std::size_t code_points;
+    // The code unit offset of every code_point_index_stride-th code point.
+    std::vector<std::size_t> offsets;
+  };
+
+  template <class FromType>
+  code_point_index build_code_point_index(FromType const* first, FromType const* last) {
+    code_point_index index{.code_points = 0, .offsets = {}};
+    index.offsets.reserve(static_cast<std::size_t>(last - first) / code_point_index_stride + 1);
+    FromType const* it = first;
+    while (it != last) {
+      std::size_t const to_checkpoint{code_point_index_stride - index.code_points % code_point_index_stride};
+      if (to_checkpoint == code_point_index_stride) {
+        index.offsets.push_back(static_cast<std::size_t>(it - first));
+      }
+      if constexpr (std::same_as<FromType, char8_t>) {
+        std::size_t const run{ascii_prefix_length(
+            it, it + std::min(static_cast<std::size_t>(last - it), to_checkpoint))};
+        if (run != 0) {
+          it += run;
+          index.code_points += run;
+          continue;
+        }
+      }
+      decode_code_point_impl<FromType>(it, last);
+      ++index.code_points;
+    }
+    return index;
+  }
+
+  // Owns the code_point_index of an indexed_utf_view, which is built the
+  // first time something asks for it. Threads that race to build it each
+  // build their own and publish it with a compare-and-swap; the losers
+  // discard theirs and use the winner's, so readers never take a lock.
+  class code_point_index_cache {
+    mutable std::atomic<code_point_index const*> index_{nullptr};
+
+  public:
+    code_point_index_cache() = default;
+    code_point_index_cache(code_point_index_cache const&) = delete;
+    code_point_index_cache& operator=(code_point_index_cache const&) = delete;
+
+    ~code_point_index_cache() {
+      delete index_.load(std::memory_order_relaxed);
+    }
+
+    template <class FromType>
+    code_point_index const& get(FromType const* first, FromType const* last) const {
+      code_point_index const* index{index_.load(std::memory_order_acquire)};
+      if (index == nullptr) {
+        std::unique_ptr<code_point_index const> built{
+            std::make_unique<code_point_index const>(build_code_point_index(first, last))};
+        if (index_.compare_exchange_strong(index, built.get(), std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+          index = built.release();
+        }
+      }
+      return *index;
+    }
+  };
+
+} // namespace detail
+
+// An opt-in alternative to to_utf32 for contiguous UTF-8 or UTF-16 that is
+// random access by code point. The first operation that needs to know where
+// a code point is, other than stepping to a neighbor, builds an index of the
+// offset of every 128th code point, so that advancing by n, subscripting, and
+// size cost at most 128 decodes rather than n. Copies of the view share the
+// index, and it is safe to build it from several threads at once. Errors are
+// replaced with U+FFFD and each counts as one code point, as with to_utf32.
+template <std::ranges::view V>
+  requires std::ranges::contiguous_range<V> && std::ranges::sized_range<V> &&
+           (std::same_as<std::ranges::range_value_t<V>, char8_t> ||
+            std::same_as<std::ranges::range_value_t<V>, char16_t>)
+class indexed_utf_view : public std::ranges::view_interface<indexed_utf_view<V>> {
+  V base_ = V();
+  std::shared_ptr<detail::code_point_index_cache> cache_ = std::make_shared<detail::code_point_index_cache>();
+
+public:
+  class iterator {
+    using from_type = std::remove_cv_t<std::ranges::range_value_t<V>>;
+
+    detail::code_point_index_cache const* cache_ = nullptr;
+    from_type const* first_ = nullptr;
+    from_type const* last_ = nullptr;
+    from_type const* pos_ = nullptr;
+    std::ptrdiff_t ordinal_ = 0;
+    char32_t value_ = 0;
+    std::uint8_t length_ = 0;
+
+    void read() {
+      if (pos_ != last_) {
+        from_type const* it = pos_;
+        value_ = detail::decode_code_point_impl<from_type>(it, last_).c;
+        length_ = static_cast<std::uint8_t>(it - pos_);
+      }
+    }
+
+    // Where the code point before pos_ starts. In UTF-8, the lead byte of a
+    // sequence ending at pos_ is at most four back; if decoding from the
+    // nearest candidate does not end at pos_, the unit before pos_ is an
+    // ill-formed subsequence of its own.
+    from_type const* previous() const {
+      if constexpr (std::same_as<from_type, char16_t>) {
+        if (pos_ - first_ >= 2 && detail::low_surrogate(pos_[-1]) && detail::high_surrogate(pos_[-2])) {
+          return pos_ - 2;
+        }
+        return pos_ - 1;
+      } else {
+        from_type const* lead = pos_ - 1;
+        for (int i = 0; i != 3 && lead != first_ && detail::continuation(*lead); ++i) {
+          --lead;
+        }
+        from_type const* it = lead;
+        detail::decode_code_point_impl<from_type>(it, last_);
+        return it == pos_ ? lead : pos_ - 1;
+      }
+    }
+
+    void seek(std::ptrdiff_t ordinal) {
+      detail::code_point_index const& index{cache_->get(first_, last_)};
+      assert(0 <= ordinal && static_cast<std::size_t>(ordinal) <= index.code_points);
+      if (static_cast<std::size_t>(ordinal) == index.code_points) {
+        pos_ = last_;
+        ordinal_ = ordinal;
+        return;
+      }
+      std::size_t const checkpoint{static_cast<std::size_t>(ordinal) / detail::code_point_index_stride};
+      pos_ = first_ + index.offsets[checkpoint];
+      ordinal_ = static_cast<std::ptrdiff_t>(checkpoint * detail::code_point_index_stride);
+      read();
+      while (ordinal_ != ordinal) {
+        ++*this;
+      }
+    }
+
+  public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = char32_t;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    iterator(detail::code_point_index_cache const* cache, from_type const* first, from_type const* last)
+        : cache_{cache}, first_{first}, last_{last}, pos_{first} {
+      read();
+    }
+
+    // The offset in the underlying range of the first code unit of the
+    // current code point.
+    std::size_t code_unit_offset() const noexcept {
+      return static_cast<std::size_t>(pos_ - first_);
+    }
+
+    value_type operator*() const {
+      return value_;
+    }
+
+    iterator& operator++() {
+      pos_ += length_;
+      ++ordinal_;
+      read();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      auto retval = *this;
+      ++*this;
+      return retval;
+    }
+
+    iterator& operator--() {
+      pos_ = previous();
+      --ordinal_;
+      read();
+      return *this;
+    }
+
+    iterator operator--(int) {
+      auto retval = *this;
+      --*this;
+      return retval;
+    }
+
+    iterator& operator+=(difference_type n) {
+      if (0 <= n && static_cast<std::size_t>(n) <= detail::code_point_index_stride) {
+        for (; n != 0; --n) {
+          ++*this;
+        }
+      } else if (n < 0 && static_cast<std::size_t>(-n) <= detail::code_point_index_stride) {
+        for (; n != 0; ++n) {
+          --*this;
+        }
+      } else {
+        seek(ordinal_ + n);
+      }
+      return *this;
+    }
+
+    iterator& operator-=(difference_type n) {
+      return *this += -n;
+    }
+
+    value_type operator[](difference_type n) const {
+      return *(*this + n);
+    }
+
+    friend iterator operator+(iterator it, difference_type n) {
+      it += n;
+      return it;
+    }
+
+    friend iterator operator+(difference_type n, iterator it) {
+      it += n;
+      return it;
+    }
+
+    friend iterator operator-(iterator it, difference_type n) {
+      it -= n;
+      return it;
+    }
+
+    friend difference_type operator-(iterator const& x, iterator const& y) {
+      return x.ordinal_ - y.ordinal_;
+    }
+
+    friend difference_type operator-(std::default_sentinel_t, iterator const& x) {
+      return static_cast<difference_type>(x.cache_->get(x.first_, x.last_).code_points) - x.ordinal_;
+    }
+
+    friend difference_type operator-(iterator const& x, std::default_sentinel_t s) {
+      return -(s - x);
+    }
+
+    friend bool operator==(iterator const& x, iterator const& y) {
+      return x.ordinal_ == y.ordinal_;
+    }
+
+    friend std::strong_ordering operator<=>(iterator const& x, iterator const& y) {
+      return x.ordinal_ <=> y.ordinal_;
+    }
+
+    friend bool operator==(iterator const& x, std::default_sentinel_t) {
+      return x.pos_ == x.last_;
+    }
+  };
+
+  indexed_utf_view()
+    requires std::default_initializable<V>
+  = default;
+
+  explicit indexed_utf_view(V base) : base_{std::move(base)} {}
+
+  indexed_utf_view(indexed_utf_view const&) = default;
+  indexed_utf_view& operator=(indexed_utf_view const&) = default;
+
+  // The index moves with the view, so iterators into it stay valid, and the
+  // moved-from view gets a fresh one to build if it is used again.
+  indexed_utf_view(indexed_utf_view&& other)
+      : base_{std::move(other.base_)},
+        cache_{std::exchange(other.cache_, std::make_shared<detail::code_point_index_cache>())} {}
+
+  indexed_utf_view& operator=(indexed_utf_view&& other) {
+    base_ = std::move(other.base_);
+    cache_ = std::exchange(other.cache_, std::make_shared<detail::code_point_index_cache>());
+    return *this;
+  }
+
+  V base() const&
+    requires std::copy_constructible<V>
+  {
+    return base_;
+  }
+
+  V base() && {
+    return std::move(base_);
+  }
+
+  iterator begin() {
+    auto const data = std::ranges::data(base_);
+    return iterator{cache_.get(), data, data + std::ranges::size(base_)};
+  }
+
+  iterator begin() const
+    requires std::ranges::contiguous_range<V const> && std::ranges::sized_range<V const>
+  {
+    auto const data = std::ranges::data(base_);
+    return iterator{cache_.get(), data, data + std::ranges::size(base_)};
+  }
+
+  std::default_sentinel_t end() const noexcept {
+    return std::default_sentinel;
+  }
+
+  std::size_t size() {
+    auto const data = std::ranges::data(base_);
+    return cache_->get(data, data + std::ranges::size(base_)).code_points;
+  }
+
+  std::size_t size() const
+    requires std::ranges::contiguous_range<V const> && std::ranges::sized_range<V const>
+  {
+    auto const data = std::ranges::data(base_);
+    return cache_->get(data, data + std::ranges::size(base_)).code_points;
+  }
+};
+
+namespace detail {
+
+  struct indexed_utf_impl : std::ranges::range_adaptor_closure<indexed_utf_impl> {
+    template <std::ranges::viewable_range R>
+      requires std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+               (std::same_as<std::ranges::range_value_t<R>, char8_t> ||
+                std::same_as<std::ranges::range_value_t<R>, char16_t>) &&
+               is_not_array_of_char<R>
+    auto operator()(R&& r) const {
+      return indexed_utf_view<std::views::all_t<R>>(std::views::all(std::forward<R>(r)));
+    }
+  };
+
+} // namespace detail
+
+inline constexpr detail::indexed_utf_impl indexed_utf;
+
+} // namespace beman::utf_view
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_INDEXED_UTF_VIEW_HPP
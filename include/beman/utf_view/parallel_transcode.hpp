@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_PARALLEL_TRANSCODE_HPP
+#define BEMAN_UTF_VIEW_PARALLEL_TRANSCODE_HPP
+
+#include <beman/utf_view/config.hpp>
+
+// This header is not part of utf_view.hpp or the beman.utf_view module, so
+// that only code that includes it pulls in <execution>. With modules, it
+// builds on what the module exports.
+#if BEMAN_UTF_VIEW_USE_MODULES()
+
+import beman.utf_view;
+import std;
+
+#else
+
+#include <beman/utf_view/detail/concepts.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcode.hpp>
+#include <beman/utf_view/transcoded_size.hpp>
+#include <beman/utf_view/validate.hpp>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <execution>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#endif
+
+namespace beman::utf_view {
+
+namespace detail {
+
+  // The number of code units of input in each chunk that the parallel
+  // overloads of transcode measure and transcode independently.
+  inline constexpr std::size_t parallel_transcode_chunk_size = std::size_t{1} << 18;
+
+  template <class FromType, class ToType>
+  struct parallel_transcode_chunk {
+    FromType const* first;
+    FromType const* last;
+    ToType* out;
+    std::size_t size;
+    std::optional<utf_transcoding_error> error;
+  };
+
+  template <class R>
+  concept contiguous_transcodable_range = transcodable_range<R> &&
+      std::ranges::contiguous_range<transcode_source_t<R>> && std::ranges::sized_range<transcode_source_t<R>>;
+
+  // Split the input into chunks at code point boundaries, measure every chunk
+  // in parallel, assign each one its place in the output with a prefix sum of
+  // the sizes, and then transcode every chunk into its place in parallel. If E
+  // is expected, the first chunk in input order that contains an error is
+  // truncated there, and nothing after it is written.
+  template <to_utf_view_error_kind E, exposition_only_code_unit ToType, class ExecutionPolicy, class R, class O>
+  auto parallel_transcode_impl(ExecutionPolicy&& policy, R&& r, O out, std::size_t chunk_size) {
+    using in_type = transcode_in_t<R>;
+    using result_type = transcode_result<in_type, O>;
+    decltype(auto) source = transcode_source(std::forward<R>(r));
+    using S = std::remove_reference_t<decltype(source)>;
+    using from_type = std::remove_cv_t<std::ranges::range_value_t<S>>;
+    using chunk = parallel_transcode_chunk<from_type, ToType>;
+
+    from_type const* const data = std::ranges::data(source);
+    from_type const* const data_end = data + std::ranges::size(source);
+    ToType* const out_first = std::to_address(out);
+
+    auto const make_result{[&](from_type const* in_last, ToType* out_last,
+                               std::optional<utf_transcoding_error> error) {
+      in_type in{};
+      if constexpr (!std::same_as<in_type, std::ranges::dangling>) {
+        in = std::ranges::begin(source) + (in_last - data);
+      }
+      return result_type{.in{std::move(in)}, .out{out + (out_last - out_first)}, .error{error}};
+    }};
+
+    if (static_cast<std::size_t>(data_end - data) <= chunk_size) {
+      auto const block_result{transcode_block<E, ToType, false>(data, data_end, out_first, out_first)};
+      return make_result(block_result.in, block_result.out, block_result.error);
+    }
+
+    std::vector<chunk> chunks;
+    for (from_type const* first = data; first != data_end;) {
+      from_type const* const last = static_cast<std::size_t>(data_end - first) <= chunk_size
+          ? data_end
+          : code_point_boundary(first + chunk_size, data_end);
+      chunks.push_back({.first = first, .last = last, .out = nullptr, .size = 0, .error = std::nullopt});
+      first = last;
+    }
+
+    std::for_each(policy, chunks.begin(), chunks.end(), [](chunk& c) {
+      auto const size{transcoded_size_impl<E, ToType>(std::ranges::subrange{c.first, c.last})};
+      if (size) {
+        c.size = *size;
+      } else {
+        c.last = c.first + size.error().offset;
+        c.error = size.error().error;
+      }
+    });
+
+    if constexpr (E == to_utf_view_error_kind::expected) {
+      auto const first_error = std::ranges::find_if(chunks, [](chunk const& c) { return c.error.has_value(); });
+      if (first_error != chunks.end()) {
+        chunks.erase(first_error + 1, chunks.end());
+      }
+    }
+
+    ToType* chunk_out = out_first;
+    for (chunk& c : chunks) {
+      c.out = chunk_out;
+      chunk_out += c.size;
+    }
+
+    std::for_each(policy, chunks.begin(), chunks.end(), [](chunk& c) {
+      auto const block_result{transcode_block<E, ToType, false>(c.first, c.last, c.out, c.out)};
+      c.size = static_cast<std::size_t>(block_result.out - c.out);
+      if (block_result.error) {
+        c.error = block_result.error;
+      }
+    });
+
+    auto const first_error = std::ranges::find_if(chunks, [](chunk const& c) { return c.error.has_value(); });
+    return make_result(chunks.back().last, chunks.back().out + chunks.back().size,
+                       first_error == chunks.end() ? std::nullopt : first_error->error);
+  }
+
+} // namespace detail
+
+// Like transcode, but for large contiguous input, which is split at code point
+// boundaries into chunks that are transcoded according to policy. The output
+// and the reported error are the same as those of the sequential overload.
+// Each chunk is written in place, so out must be contiguous storage of ToType.
+template <exposition_only_code_unit ToType, class ExecutionPolicy, class R, std::contiguous_iterator O>
+  requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+           detail::contiguous_transcodable_range<R> && std::same_as<std::iter_value_t<O>, ToType> &&
+           std::indirectly_writable<O, ToType const&>
+transcode_result<detail::transcode_in_t<R>, O> transcode(ExecutionPolicy&& policy, R&& r, O out) {
+  return detail::parallel_transcode_impl<to_utf_view_error_kind::replacement, ToType>(
+      policy, std::forward<R>(r), std::move(out), detail::parallel_transcode_chunk_size);
+}
+
+template <class ExecutionPolicy, class R, std::contiguous_iterator O>
+  requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+           detail::contiguous_transcodable_range<R> && exposition_only_code_unit<std::iter_value_t<O>> &&
+           std::indirectly_writable<O, std::iter_value_t<O> const&>
+transcode_result<detail::transcode_in_t<R>, O> transcode(ExecutionPolicy&& policy, R&& r, O out) {
+  return detail::parallel_transcode_impl<to_utf_view_error_kind::replacement, std::iter_value_t<O>>(
+      policy, std::forward<R>(r), std::move(out), detail::parallel_transcode_chunk_size);
+}
+
+// Like transcode_or_error, but parallel in the same way as transcode above.
+// Chunks after the one containing the first error are not written.
+template <exposition_only_code_unit ToType, class ExecutionPolicy, class R, std::contiguous_iterator O>
+  requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+           detail::contiguous_transcodable_range<R> && std::same_as<std::iter_value_t<O>, ToType> &&
+           std::indirectly_writable<O, ToType const&>
+transcode_result<detail::transcode_in_t<R>, O> transcode_or_error(ExecutionPolicy&& policy, R&& r, O out) {
+  return detail::parallel_transcode_impl<to_utf_view_error_kind::expected, ToType>(
+      policy, std::forward<R>(r), std::move(out), detail::parallel_transcode_chunk_size);
+}
+
+template <class ExecutionPolicy, class R, std::contiguous_iterator O>
+  requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>> &&
+           detail::contiguous_transcodable_range<R> && exposition_only_code_unit<std::iter_value_t<O>> &&
+           std::indirectly_writable<O, std::iter_value_t<O> const&>
+transcode_result<detail::transcode_in_t<R>, O> transcode_or_error(ExecutionPolicy&& policy, R&& r, O out) {
+  return detail::parallel_transcode_impl<to_utf_view_error_kind::expected, std::iter_value_t<O>>(
+      policy, std::forward<R>(r), std::move(out), detail::parallel_transcode_chunk_size);
+}
+
+} // namespace beman::utf_view
+
+#endif // BEMAN_UTF_VIEW_PARALLEL_TRANSCODE_HPP
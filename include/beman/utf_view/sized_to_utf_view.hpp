@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_SIZED_TO_UTF_VIEW_HPP
+#define BEMAN_UTF_VIEW_SIZED_TO_UTF_VIEW_HPP
+
+#include <beman/utf_view/config.hpp>
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#include <beman/utf_view/detail/concepts.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/utf_distance.hpp>
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace beman::utf_view {
+
+namespace detail {
+
+  template <class V>
+  struct to_utf_view_traits;
+
+  template <class V, to_utf_view_error_kind E, class ToType>
+  struct to_utf_view_traits<to_utf_view<V, E, ToType>> {
+    using base_type = V;
+    using to_type = ToType;
+    static constexpr to_utf_view_error_kind error_kind = E;
+  };
+
+  // Whether the size of V, a to_utf_view, can be computed from a copy of its
+  // base, which unlike V itself is iterable when const.
+  template <class V>
+  concept to_utf_view_with_copyable_base = std::copy_constructible<typename to_utf_view_traits<V>::base_type>;
+
+  // The number of elements of v, computed from its base: the well-formed runs
+  // of contiguous input are measured by counting lead bytes and surrogates,
+  // and anything else is decoded a code point at a time.
+  template <class V>
+    requires to_utf_view_with_copyable_base<V>
+  constexpr std::size_t to_utf_view_size(V const& v) {
+    using traits = to_utf_view_traits<V>;
+    using S = typename traits::base_type;
+    using from_type = std::remove_cv_t<std::ranges::range_value_t<S>>;
+    constexpr to_utf_view_error_kind E = traits::error_kind;
+    S source{v.base()};
+    if constexpr (std::ranges::contiguous_range<S> && std::ranges::sized_range<S>) {
+      from_type const* const first = std::ranges::data(source);
+      return utf_elements<E, typename traits::to_type>(first, first + std::ranges::size(source));
+    } else {
+      std::size_t size{};
+      auto it = std::ranges::begin(source);
+      auto const last = std::ranges::end(source);
+      while (it != last) {
+        size += code_point_elements<E, typename traits::to_type>(decode_code_point_impl<from_type>(it, last));
+      }
+      return size;
+    }
+  }
+
+  // The same, for a to_utf_view whose base cannot be copied, by iterating
+  // over v itself.
+  template <class V>
+  constexpr std::size_t iterated_to_utf_view_size(V& v) {
+    if constexpr (contiguous_to_utf_iterator<std::ranges::iterator_t<V>>) {
+      return static_cast<std::size_t>(utf_distance(v));
+    } else {
+      return static_cast<std::size_t>(std::ranges::distance(v));
+    }
+  }
+
+  // The size of a sized_to_utf_view, once something has asked for it. Threads
+  // that race to compute it each compute the same value and store it, so
+  // readers never take a lock. Copies keep what is known, which also holds
+  // for the copy of the view.
+  class cached_size {
+    static constexpr std::size_t unknown = static_cast<std::size_t>(-1);
+
+    alignas(std::atomic_ref<std::size_t>::required_alignment) mutable std::size_t size_ = unknown;
+
+    constexpr std::size_t load() const {
+      if !consteval {
+        return std::atomic_ref<std::size_t>{size_}.load(std::memory_order_relaxed);
+      }
+      return size_;
+    }
+
+    constexpr void store(std::size_t size) const {
+      if !consteval {
+        std::atomic_ref<std::size_t>{size_}.store(size, std::memory_order_relaxed);
+        return;
+      }
+      size_ = size;
+    }
+
+  public:
+    constexpr cached_size() = default;
+
+    constexpr cached_size(cached_size const& other) : size_{other.load()} {}
+
+    constexpr cached_size& operator=(cached_size const& other) {
+      store(other.load());
+      return *this;
+    }
+
+    // The cached size, or compute() if there is none yet.
+    template <class Compute>
+    constexpr std::size_t get(Compute compute) const {
+      std::size_t size{load()};
+      if (size == unknown) {
+        size = compute();
+        store(size);
+      }
+      return size;
+    }
+  };
+
+} // namespace detail
+
+// A to_utf_view over a forward range that models sized_range. The first call
+// to size() counts the elements, measuring well-formed stretches of
+// contiguous input by their lead bytes or surrogates as utf_distance does,
+// and later calls return the count. That lets std::ranges::to and container
+// insertion allocate exactly once, and gives views::take and views::drop
+// their size arithmetic. Iterating over it is iterating over V, and empty()
+// does not compute the size.
+template <std::ranges::view V>
+  requires detail::is_to_utf_view_v<V> && std::ranges::forward_range<V>
+class sized_to_utf_view : public std::ranges::view_interface<sized_to_utf_view<V>> {
+  V base_ = V();
+  detail::cached_size size_;
+
+public:
+  sized_to_utf_view()
+    requires std::default_initializable<V>
+  = default;
+
+  constexpr explicit sized_to_utf_view(V base) : base_{std::move(base)} {}
+
+  constexpr V base() const&
+    requires std::copy_constructible<V>
+  {
+    return base_;
+  }
+
+  constexpr V base() && {
+    return std::move(base_);
+  }
+
+  constexpr auto begin() {
+    return std::ranges::begin(base_);
+  }
+
+  constexpr auto begin() const
+    requires std::ranges::forward_range<V const>
+  {
+    return std::ranges::begin(base_);
+  }
+
+  constexpr auto end() {
+    return std::ranges::end(base_);
+  }
+
+  constexpr auto end() const
+    requires std::ranges::forward_range<V const>
+  {
+    return std::ranges::end(base_);
+  }
+
+  constexpr bool empty() const {
+    return base_.empty();
+  }
+
+  constexpr std::size_t size() {
+    return size_.get([&] {
+      if constexpr (detail::to_utf_view_with_copyable_base<V>) {
+        return detail::to_utf_view_size(std::as_const(base_));
+      } else {
+        return detail::iterated_to_utf_view_size(base_);
+      }
+    });
+  }
+
+  constexpr std::size_t size() const
+    requires detail::to_utf_view_with_copyable_base<V>
+  {
+    return size_.get([&] { return detail::to_utf_view_size(base_); });
+  }
+};
+
+template <class R>
+sized_to_utf_view(R&&) -> sized_to_utf_view<std::views::all_t<R>>;
+
+namespace detail {
+
+  struct sized_utf_impl : std::ranges::range_adaptor_closure<sized_utf_impl> {
+    // The to_utf adaptors return views that are already sized in some cases,
+    // such as for empty input, and those are passed through as they are.
+    template <std::ranges::viewable_range R>
+      requires std::ranges::sized_range<R> ||
+               (is_to_utf_view_v<std::remove_cvref_t<R>> && std::ranges::forward_range<R>)
+    constexpr auto operator()(R&& r) const {
+      if constexpr (std::ranges::sized_range<R>) {
+        return std::views::all(std::forward<R>(r));
+      } else {
+        return sized_to_utf_view<std::views::all_t<R>>(std::views::all(std::forward<R>(r)));
+      }
+    }
+  };
+
+} // namespace detail
+
+inline constexpr detail::sized_utf_impl sized_utf;
+
+} // namespace beman::utf_view
+
+template <class V>
+inline constexpr bool std::ranges::enable_borrowed_range<beman::utf_view::sized_to_utf_view<V>> =
+    std::ranges::enable_borrowed_range<V>;
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_SIZED_TO_UTF_VIEW_HPP
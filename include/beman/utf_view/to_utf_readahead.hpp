@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_TO_UTF_READAHEAD_HPP
+#define BEMAN_UTF_VIEW_TO_UTF_READAHEAD_HPP
+
+#include <beman/utf_view/config.hpp>
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#include <beman/utf_view/detail/concepts.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcode.hpp>
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace beman::utf_view {
+
+// An opt-in alternative to to_utf that trades laziness for throughput. Rather
+// than decoding one code point per increment, its iterator transcodes the
+// input into a 64-byte buffer at a time with the block decoder, so runs of
+// ASCII are copied with vector instructions and the increment in the common
+// case is a buffer index bump.
+//
+// The cost is that the iterator is about 90 bytes, that it only models
+// forward_iterator, and that it reads up to 64 bytes' worth of output ahead of
+// the element it refers to. Errors are replaced with U+FFFD, as with to_utf.
+// Only contiguous, sized ranges of code units are accepted.
+template <std::ranges::view V, exposition_only_code_unit ToType>
+  requires std::ranges::contiguous_range<V> && std::ranges::sized_range<V> &&
+           exposition_only_code_unit<std::ranges::range_value_t<V>>
+class to_utf_readahead_view : public std::ranges::view_interface<to_utf_readahead_view<V, ToType>> {
+  V base_ = V();
+
+public:
+  class iterator {
+    using from_type = std::remove_cv_t<std::ranges::range_value_t<V>>;
+
+    static constexpr std::size_t capacity = 64 / sizeof(ToType);
+
+    from_type const* pos_ = nullptr;
+    from_type const* next_ = nullptr;
+    from_type const* last_ = nullptr;
+    std::uint8_t buf_index_ = 0;
+    std::uint8_t buf_size_ = 0;
+    ToType buf_[capacity]{};
+
+    // Transcode the next block of the input into buf_. pos_ records where the
+    // block started, so that two iterators over the same element compare
+    // equal regardless of how they got there.
+    constexpr void refill() {
+      detail::transcode_block_result<from_type, ToType> const result{
+          detail::transcode_block<to_utf_view_error_kind::replacement, ToType, true>(
+              next_, last_, buf_, buf_ + capacity)};
+      pos_ = next_;
+      next_ = result.in;
+      buf_index_ = 0;
+      buf_size_ = static_cast<std::uint8_t>(result.out - buf_);
+    }
+
+  public:
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type = ToType;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr iterator() = default;
+
+    constexpr iterator(from_type const* first, from_type const* last)
+        : pos_{first}, next_{first}, last_{last} {
+      refill();
+    }
+
+    constexpr value_type operator*() const {
+      return buf_[buf_index_];
+    }
+
+    constexpr iterator& operator++() {
+      if (++buf_index_ == buf_size_ && next_ != last_) {
+        refill();
+      }
+      return *this;
+    }
+
+    constexpr iterator operator++(int) {
+      auto retval = *this;
+      ++*this;
+      return retval;
+    }
+
+    friend constexpr bool operator==(iterator const& x, iterator const& y) {
+      return x.pos_ == y.pos_ && x.buf_index_ == y.buf_index_;
+    }
+
+    friend constexpr bool operator==(iterator const& x, std::default_sentinel_t) {
+      return x.buf_index_ == x.buf_size_;
+    }
+  };
+
+  to_utf_readahead_view()
+    requires std::default_initializable<V>
+  = default;
+
+  constexpr explicit to_utf_readahead_view(V base) : base_{std::move(base)} {}
+
+  constexpr V base() const&
+    requires std::copy_constructible<V>
+  {
+    return base_;
+  }
+
+  constexpr V base() && {
+    return std::move(base_);
+  }
+
+  constexpr iterator begin() {
+    auto const data = std::ranges::data(base_);
+    return iterator{data, data + std::ranges::size(base_)};
+  }
+
+  constexpr iterator begin() const
+    requires std::ranges::contiguous_range<V const> && std::ranges::sized_range<V const>
+  {
+    auto const data = std::ranges::data(base_);
+    return iterator{data, data + std::ranges::size(base_)};
+  }
+
+  constexpr std::default_sentinel_t end() const noexcept {
+    return std::default_sentinel;
+  }
+};
+
+namespace detail {
+
+  template <exposition_only_code_unit ToType>
+  struct to_utf_readahead_impl : std::ranges::range_adaptor_closure<to_utf_readahead_impl<ToType>> {
+    template <std::ranges::viewable_range R>
+      requires std::ranges::contiguous_range<R> && std::ranges::sized_range<R> &&
+               exposition_only_code_unit<std::ranges::range_value_t<R>> && is_not_array_of_char<R>
+    constexpr auto operator()(R&& r) const {
+      return to_utf_readahead_view<std::views::all_t<R>, ToType>(std::views::all(std::forward<R>(r)));
+    }
+  };
+
+} // namespace detail
+
+template <exposition_only_code_unit ToType>
+inline constexpr detail::to_utf_readahead_impl<ToType> to_utf_readahead;
+
+inline constexpr detail::to_utf_readahead_impl<char8_t> to_utf8_readahead;
+
+inline constexpr detail::to_utf_readahead_impl<char16_t> to_utf16_readahead;
+
+inline constexpr detail::to_utf_readahead_impl<char32_t> to_utf32_readahead;
+
+} // namespace beman::utf_view
+
+template <class V, class ToType>
+inline constexpr bool std::ranges::enable_borrowed_range<beman::utf_view::to_utf_readahead_view<V, ToType>> =
+    std::ranges::enable_borrowed_range<V>;
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_TO_UTF_READAHEAD_HPP
@@ -17,11 +17,15 @@ import beman.utf_view;
 
 #else
 
+#include <beman/utf_view/code_unit_view.hpp>
 #include <beman/utf_view/detail/concepts.hpp>
 #include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
-#include <beman/utf_view/detail/fake_inplace_vector.hpp>
 #include <beman/utf_view/detail/constant_wrapper_polyfill.hpp>
+#include <beman/utf_view/detail/simd.hpp>
+#include <beman/utf_view/endian_view.hpp>
 #if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <beman/transform_view/transform_view.hpp>
+#include <algorithm>
 #include <bit>
 #include <cassert>
 #include <concepts>
@@ -104,10 +108,20 @@ enum class utf_transcoding_error {
   invalid_utf8_leading_byte
 };
 
-enum class to_utf_view_error_kind : bool {
+/* !PAPER */
+enum class to_utf_view_error_kind : unsigned char {
   replacement,
-  expected
+  expected,
+  // The input is known to be well formed, so it is decoded without being
+  // checked, other than by assertions. Ill-formed input is undefined
+  // behavior.
+  assume_valid
 };
+/* PAPER */
+/* PAPER: enum class to_utf_view_error_kind : bool { */
+/* PAPER:   replacement, */
+/* PAPER:   expected */
+/* PAPER: }; */
 
 template <exposition_only_code_unit ToType>
 struct to_utf_tag_t {
@@ -119,15 +133,696 @@ constexpr to_utf_tag_t<ToType> to_utf_tag{};
 
 using to_utf8_tag_t = to_utf_tag_t<char8_t>;
 
-constexpr to_utf8_tag_t to_utf8_tag{};
+constexpr to_utf8_tag_t to_utf8_tag{};
+
+using to_utf16_tag_t = to_utf_tag_t<char16_t>;
+
+constexpr to_utf16_tag_t to_utf16_tag{};
+
+using to_utf32_tag_t = to_utf_tag_t<char32_t>;
+
+constexpr to_utf32_tag_t to_utf32_tag{};
+
+/* !PAPER */
+
+namespace detail {
+
+  struct decode_code_point_result {
+    char32_t c;
+    std::uint8_t to_incr;
+    std::expected<void, utf_transcoding_error> success;
+  };
+
+  // Each of these decodes one code point starting at it, leaving it one past
+  // the last code unit consumed (i.e. advanced by to_incr). Ill-formed
+  // subsequences are handled per the maximal subpart rules of Unicode 3.9.
+
+  template <std::input_iterator I, std::sentinel_for<I> S>
+  constexpr decode_code_point_result decode_code_point_utf8_cascade_impl(I& it, S const& last) {
+    char32_t c{};
+    std::uint8_t u = *it;
+    ++it;
+    const std::uint8_t lo_bound = 0x80, hi_bound = 0xBF;
+    std::uint8_t to_incr = 1;
+    std::expected<void, utf_transcoding_error> success{};
+
+    auto const error{[&](utf_transcoding_error const error_enum_in) {
+      success = std::unexpected{error_enum_in};
+      c = U'\uFFFD';
+    }};
+
+    if (u <= 0x7F) [[likely]] // 0x00 to 0x7F
+      c = u;
+    else if (u < 0xC0) [[unlikely]] {
+      error(utf_transcoding_error::unexpected_utf8_continuation_byte);
+    } else if (u < 0xC2 || u > 0xF4) [[unlikely]] {
+      error(utf_transcoding_error::invalid_utf8_leading_byte);
+    } else if (it == last) [[unlikely]] {
+      error(utf_transcoding_error::truncated_utf8_sequence);
+    } else if (u <= 0xDF) // 0xC2 to 0xDF
+    {
+      c = u & 0x1F;
+      u = *it;
+
+      if (u < lo_bound || u > hi_bound) [[unlikely]]
+        error(utf_transcoding_error::truncated_utf8_sequence);
+      else {
+        c = (c << 6) | (u & 0x3F);
+        ++it;
+        ++to_incr;
+      }
+    } else if (u <= 0xEF) // 0xE0 to 0xEF
+    {
+      std::uint8_t orig = u;
+      c = u & 0x0F;
+      u = *it;
+
+      if (orig == 0xE0 && 0x80 <= u && u < 0xA0) [[unlikely]]
+        error(utf_transcoding_error::overlong);
+      else if (orig == 0xED && 0xA0 <= u && u < 0xC0) [[unlikely]]
+        error(utf_transcoding_error::encoded_surrogate);
+      else if (u < lo_bound || u > hi_bound) [[unlikely]]
+        error(utf_transcoding_error::truncated_utf8_sequence);
+      else if (++it == last) {
+        [[unlikely]]++ to_incr;
+        error(utf_transcoding_error::truncated_utf8_sequence);
+      } else {
+        ++to_incr;
+        c = (c << 6) | (u & 0x3F);
+        u = *it;
+
+        if (u < lo_bound || u > hi_bound) [[unlikely]]
+          error(utf_transcoding_error::truncated_utf8_sequence);
+        else {
+          c = (c << 6) | (u & 0x3F);
+          ++it;
+          ++to_incr;
+        }
+      }
+    } else if (u <= 0xF4) // 0xF0 to 0xF4
+    {
+      std::uint8_t orig = u;
+      c = u & 0x07;
+      u = *it;
+
+      if (orig == 0xF0 && 0x80 <= u && u < 0x90) [[unlikely]]
+        error(utf_transcoding_error::overlong);
+      else if (orig == 0xF4 && 0x90 <= u && u < 0xC0) [[unlikely]]
+        error(utf_transcoding_error::out_of_range);
+      else if (u < lo_bound || u > hi_bound) [[unlikely]]
+        error(utf_transcoding_error::truncated_utf8_sequence);
+      else if (++it == last) {
+        [[unlikely]]++ to_incr;
+        error(utf_transcoding_error::truncated_utf8_sequence);
+      } else {
+        ++to_incr;
+        c = (c << 6) | (u & 0x3F);
+        u = *it;
+
+        if (u < lo_bound || u > hi_bound) [[unlikely]]
+          error(utf_transcoding_error::truncated_utf8_sequence);
+        else if (++it == last) {
+          [[unlikely]]++ to_incr;
+          error(utf_transcoding_error::truncated_utf8_sequence);
+        } else {
+          ++to_incr;
+          c = (c << 6) | (u & 0x3F);
+          u = *it;
+
+          if (u < lo_bound || u > hi_bound) [[unlikely]]
+            error(utf_transcoding_error::truncated_utf8_sequence);
+          else {
+            c = (c << 6) | (u & 0x3F);
+            ++it;
+            ++to_incr;
+          }
+        }
+      }
+    }
+
+    return {.c{c}, .to_incr{to_incr}, .success{success}};
+  }
+
+  // A table-driven UTF-8 decoder after Hoehrmann, "Flexible and Economical
+  // UTF-8 Decoder". Each byte maps to one of twelve classes, and the current
+  // state plus the class of the next byte index a transition table. Rejecting
+  // entries carry the error to report, so the decoder classifies ill-formed
+  // input exactly like decode_code_point_utf8_cascade_impl, but without a
+  // branch on the kind of lead byte.
+  namespace utf8_dfa {
+
+    enum byte_class : std::uint8_t {
+      ascii,
+      continuation_80_8f,
+      continuation_90_9f,
+      continuation_a0_bf,
+      invalid_lead,
+      lead_2,
+      lead_e0,
+      lead_3,
+      lead_ed,
+      lead_f0,
+      lead_4,
+      lead_f4
+    };
+
+    inline constexpr std::size_t class_count = 16;
+    inline constexpr std::size_t state_count = 8;
+
+    // The states are the offsets of their rows in the transition table, and
+    // the continuation bytes each one accepts.
+    enum state : std::uint8_t {
+      accept = 0,
+      need_1 = 1 * class_count,      // 80..BF
+      need_2 = 2 * class_count,      // 80..BF 80..BF
+      need_3 = 3 * class_count,      // 80..BF 80..BF 80..BF
+      after_e0 = 4 * class_count,    // A0..BF 80..BF
+      after_ed = 5 * class_count,    // 80..9F 80..BF
+      after_f0 = 6 * class_count,    // 90..BF 80..BF 80..BF
+      after_f4 = 7 * class_count,    // 80..8F 80..BF 80..BF
+      reject = 0x80 // Or'd with the utf_transcoding_error to report.
+    };
+
+    struct tables {
+      std::uint8_t classes[256];
+      std::uint8_t lead_masks[class_count];
+      std::uint8_t transitions[state_count * class_count];
+    };
+
+    consteval tables make_tables() {
+      tables result{};
+      for (int u = 0; u != 256; ++u) {
+        result.classes[u] = u < 0x80   ? ascii
+            : u < 0x90                 ? continuation_80_8f
+            : u < 0xA0                 ? continuation_90_9f
+            : u < 0xC0                 ? continuation_a0_bf
+            : u < 0xC2                 ? invalid_lead
+            : u < 0xE0                 ? lead_2
+            : u == 0xE0                ? lead_e0
+            : u == 0xED                ? lead_ed
+            : u < 0xF0                 ? lead_3
+            : u == 0xF0                ? lead_f0
+            : u < 0xF4                 ? lead_4
+            : u == 0xF4                ? lead_f4
+                                       : invalid_lead;
+      }
+
+      result.lead_masks[ascii] = 0x7F;
+      result.lead_masks[lead_2] = 0x1F;
+      result.lead_masks[lead_e0] = result.lead_masks[lead_3] = result.lead_masks[lead_ed] = 0x0F;
+      result.lead_masks[lead_f0] = result.lead_masks[lead_4] = result.lead_masks[lead_f4] = 0x07;
+
+      auto const error{[](utf_transcoding_error e) {
+        return static_cast<std::uint8_t>(reject | static_cast<std::uint8_t>(e));
+      }};
+      auto const row{[&result](state s) { return result.transitions + s; }};
+      for (std::uint8_t& transition : result.transitions) {
+        transition = error(utf_transcoding_error::truncated_utf8_sequence);
+      }
+      std::uint8_t const continuations[]{continuation_80_8f, continuation_90_9f, continuation_a0_bf};
+
+      row(accept)[ascii] = accept;
+      for (std::uint8_t const k : continuations) {
+        row(accept)[k] = error(utf_transcoding_error::unexpected_utf8_continuation_byte);
+      }
+      row(accept)[invalid_lead] = error(utf_transcoding_error::invalid_utf8_leading_byte);
+      row(accept)[lead_2] = need_1;
+      row(accept)[lead_e0] = after_e0;
+      row(accept)[lead_3] = need_2;
+      row(accept)[lead_ed] = after_ed;
+      row(accept)[lead_f0] = after_f0;
+      row(accept)[lead_4] = need_3;
+      row(accept)[lead_f4] = after_f4;
+
+      for (std::uint8_t const k : continuations) {
+        row(need_1)[k] = accept;
+        row(need_2)[k] = need_1;
+        row(need_3)[k] = need_2;
+      }
+      row(after_e0)[continuation_80_8f] = error(utf_transcoding_error::overlong);
+      row(after_e0)[continuation_90_9f] = error(utf_transcoding_error::overlong);
+      row(after_e0)[continuation_a0_bf] = need_1;
+      row(after_ed)[continuation_80_8f] = need_1;
+      row(after_ed)[continuation_90_9f] = need_1;
+      row(after_ed)[continuation_a0_bf] = error(utf_transcoding_error::encoded_surrogate);
+      row(after_f0)[continuation_80_8f] = error(utf_transcoding_error::overlong);
+      row(after_f0)[continuation_90_9f] = need_2;
+      row(after_f0)[continuation_a0_bf] = need_2;
+      row(after_f4)[continuation_80_8f] = need_2;
+      row(after_f4)[continuation_90_9f] = error(utf_transcoding_error::out_of_range);
+      row(after_f4)[continuation_a0_bf] = error(utf_transcoding_error::out_of_range);
+      return result;
+    }
+
+    inline constexpr tables dfa_tables{make_tables()};
+
+  } // namespace utf8_dfa
+
+  template <std::input_iterator I, std::sentinel_for<I> S>
+  constexpr decode_code_point_result decode_code_point_utf8_dfa_impl(I& it, S const& last) {
+    std::uint8_t u = *it;
+    ++it;
+    std::uint8_t const lead_class{utf8_dfa::dfa_tables.classes[u]};
+    std::uint8_t state{utf8_dfa::dfa_tables.transitions[lead_class]};
+    char32_t c = u & utf8_dfa::dfa_tables.lead_masks[lead_class];
+    std::uint8_t to_incr = 1;
+
+    auto const error{[&](std::uint8_t const rejection) -> decode_code_point_result {
+      return {.c{U'\uFFFD'},
+              .to_incr{to_incr},
+              .success{std::unexpected{static_cast<utf_transcoding_error>(rejection & ~utf8_dfa::reject)}}};
+    }};
+
+    if (state & utf8_dfa::reject) [[unlikely]] {
+      return error(state);
+    }
+    while (state != utf8_dfa::accept) {
+      if (it == last) [[unlikely]] {
+        return error(utf8_dfa::reject | static_cast<std::uint8_t>(utf_transcoding_error::truncated_utf8_sequence));
+      }
+      u = *it;
+      state = utf8_dfa::dfa_tables.transitions[state + utf8_dfa::dfa_tables.classes[u]];
+      if (state & utf8_dfa::reject) [[unlikely]] {
+        return error(state);
+      }
+      c = (c << 6) | (u & 0x3F);
+      ++it;
+      ++to_incr;
+    }
+    return {.c{c}, .to_incr{to_incr}, .success{}};
+  }
+
+  // The UTF-8 decoder used by the views and algorithms, which is the
+  // table-driven one if BEMAN_UTF_VIEW_UTF8_DFA_DECODER is enabled.
+  template <std::input_iterator I, std::sentinel_for<I> S>
+  constexpr decode_code_point_result decode_code_point_utf8_impl(I& it, S const& last) {
+    if constexpr (BEMAN_UTF_VIEW_UTF8_DFA_DECODER()) {
+      return decode_code_point_utf8_dfa_impl(it, last);
+    } else {
+      return decode_code_point_utf8_cascade_impl(it, last);
+    }
+  }
+
+  template <std::input_iterator I, std::sentinel_for<I> S>
+  constexpr decode_code_point_result decode_code_point_utf16_impl(I& it, S const& last) {
+    char32_t c{};
+    std::uint16_t u = *it;
+    ++it;
+    std::uint8_t to_incr = 1;
+    std::expected<void, utf_transcoding_error> success{};
+
+    auto const error{[&](utf_transcoding_error const error_enum_in) {
+      success = std::unexpected{error_enum_in};
+      c = U'\uFFFD';
+    }};
+
+    if (u < 0xD800 || u > 0xDFFF) [[likely]]
+      c = u;
+    else if (u < 0xDC00) {
+      if (it == last) [[unlikely]] {
+        error(utf_transcoding_error::unpaired_high_surrogate);
+      } else {
+        std::uint16_t u2 = *it;
+        if (u2 < 0xDC00 || u2 > 0xDFFF) [[unlikely]]
+          error(utf_transcoding_error::unpaired_high_surrogate);
+        else {
+          ++it;
+          to_incr = 2;
+          std::uint32_t x = (u & 0x3F) << 10 | (u2 & 0x3FF);
+          std::uint32_t w = (u >> 6) & 0x1F;
+          c = (w + 1) << 16 | x;
+        }
+      }
+    } else
+      error(utf_transcoding_error::unpaired_low_surrogate);
+
+    return {.c{c}, .to_incr{to_incr}, .success{success}};
+  }
+
+  template <std::input_iterator I>
+  constexpr decode_code_point_result decode_code_point_utf32_impl(I& it) {
+    char32_t c = *it;
+    std::expected<void, utf_transcoding_error> success{};
+    ++it;
+    auto const error{[&](utf_transcoding_error const error_enum_in) {
+      success = std::unexpected{error_enum_in};
+      c = U'\uFFFD';
+    }};
+    if (c >= 0xD800) {
+      if (c < 0xE000) {
+        error(utf_transcoding_error::encoded_surrogate);
+      }
+      if (c > 0x10FFFF) {
+        error(utf_transcoding_error::out_of_range);
+      }
+    }
+    return {.c{c}, .to_incr{1}, .success{success}};
+  }
+
+  template <exposition_only_code_unit FromType, std::input_iterator I, std::sentinel_for<I> S>
+  constexpr decode_code_point_result decode_code_point_impl(I& it, S const& last) {
+    if constexpr (std::is_same_v<std::remove_cv_t<FromType>, char8_t>) {
+      return decode_code_point_utf8_impl(it, last);
+    } else if constexpr (std::is_same_v<std::remove_cv_t<FromType>, char16_t>) {
+      return decode_code_point_utf16_impl(it, last);
+    } else {
+      return decode_code_point_utf32_impl(it);
+    }
+  }
+
+  // Each of these decodes one code point starting at it, which must begin a
+  // well-formed code unit sequence, leaving it one past the last code unit
+  // consumed. Nothing is checked except by assertions, so the result is
+  // always a success.
+
+  template <std::input_iterator I, std::sentinel_for<I> S>
+  constexpr decode_code_point_result decode_code_point_utf8_unchecked_impl(I& it, [[maybe_unused]] S const& last) {
+    std::uint8_t const lead = *it;
+    ++it;
+    if (lead <= 0x7F) [[likely]] {
+      return {.c{lead}, .to_incr{1}, .success{}};
+    }
+    int const length{utf8_code_units(lead)};
+    assert(1 < length);
+    char32_t c = lead & (0x7F >> length);
+    for (int i = 1; i != length; ++i) {
+      assert(it != last);
+      std::uint8_t const u = *it;
+      assert(continuation(u));
+      c = c << 6 | (u & 0x3F);
+      ++it;
+    }
+    assert(length == 2 ? 0x80 <= c : length == 3 ? 0x800 <= c : 0x10000 <= c);
+    assert(c < 0xD800 || (0xDFFF < c && c <= 0x10FFFF));
+    return {.c{c}, .to_incr{static_cast<std::uint8_t>(length)}, .success{}};
+  }
+
+  template <std::input_iterator I, std::sentinel_for<I> S>
+  constexpr decode_code_point_result decode_code_point_utf16_unchecked_impl(I& it, [[maybe_unused]] S const& last) {
+    std::uint16_t const u = *it;
+    ++it;
+    if (u < 0xD800 || u > 0xDFFF) [[likely]] {
+      return {.c{u}, .to_incr{1}, .success{}};
+    }
+    assert(high_surrogate(u));
+    assert(it != last);
+    std::uint16_t const u2 = *it;
+    assert(low_surrogate(u2));
+    ++it;
+    return {.c{0x10000 + (static_cast<char32_t>(u - 0xD800) << 10) + (u2 - 0xDC00)}, .to_incr{2}, .success{}};
+  }
+
+  template <std::input_iterator I>
+  constexpr decode_code_point_result decode_code_point_utf32_unchecked_impl(I& it) {
+    char32_t const c = *it;
+    ++it;
+    assert(c < 0xD800 || (0xDFFF < c && c <= 0x10FFFF));
+    return {.c{c}, .to_incr{1}, .success{}};
+  }
+
+  template <exposition_only_code_unit ToType>
+  inline constexpr std::size_t max_code_units = 4 / sizeof(ToType);
+
+  // The number of code units encode_code_point<ToType> writes for c.
+  template <exposition_only_code_unit ToType>
+  constexpr std::size_t encoded_length(char32_t c) {
+    if constexpr (std::is_same_v<ToType, char32_t>) {
+      return 1;
+    } else if constexpr (std::is_same_v<ToType, char16_t>) {
+      return 1 + static_cast<std::size_t>(0xFFFF < c);
+    } else {
+      return 1 + static_cast<std::size_t>(0x7F < c) + static_cast<std::size_t>(0x7FF < c) +
+          static_cast<std::size_t>(0xFFFF < c);
+    }
+  }
+
+  // The most ToType code units that one code unit of well-formed FromType
+  // input transcodes to: a byte of UTF-8 is at most one code point, a unit
+  // of UTF-16 at most three bytes of UTF-8 (a surrogate pair is four), and a
+  // UTF-32 code point at most max_code_units<ToType> units.
+  template <exposition_only_code_unit FromType, exposition_only_code_unit ToType>
+  inline constexpr std::size_t max_units_per_unit = sizeof(FromType) <= sizeof(ToType) ? 1
+      : std::is_same_v<FromType, char16_t>                                           ? 3
+                                                                                     : max_code_units<ToType>;
+
+  // The ToType code units that the code unit u accounts for, such that their
+  // sum over well-formed input is its transcoded size: a code point's units
+  // are all attributed to its first code unit.
+  template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+  constexpr std::size_t output_units_of(FromType u) {
+    if constexpr (std::is_same_v<FromType, ToType>) {
+      return 1;
+    } else if constexpr (std::is_same_v<FromType, char8_t>) {
+      if (continuation(u)) {
+        return 0;
+      }
+      return std::is_same_v<ToType, char16_t> && 0xF0 <= u ? 2 : 1;
+    } else if constexpr (std::is_same_v<FromType, char16_t>) {
+      if (low_surrogate(u)) {
+        return 0;
+      }
+      if constexpr (std::is_same_v<ToType, char32_t>) {
+        return 1;
+      } else {
+        return high_surrogate(u) ? 4 : encoded_length<char8_t>(u);
+      }
+    } else {
+      return encoded_length<ToType>(u);
+    }
+  }
+
+  // Inputs shorter than this get the bound as their reserve hint, and longer
+  // ones an estimate from every reserve_hint_sample_stride-th code unit. The
+  // stride is prime, so that in text made of sequences of two to four code
+  // units the samples do not all land on the same unit of each sequence,
+  // such as a continuation byte or low surrogate, which account for nothing.
+  inline constexpr std::size_t reserve_hint_sample_threshold = 4096;
+  inline constexpr std::size_t reserve_hint_sample_stride = 61;
+
+  // An estimate of the number of ToType code units that the n code units at
+  // first transcode to, for to_utf_view's reserve_hint. Short input, and input
+  // whose encoding fixes the ratio, gets n * max_units_per_unit. Otherwise
+  // every 61st code unit is looked at and what they account for is scaled up,
+  // plus a sixteenth so that a slightly low estimate does not cost a
+  // reallocation, but never past the bound.
+  template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+  constexpr std::size_t estimated_transcoded_size(FromType const* first, std::size_t n) {
+    std::size_t const bound{n * max_units_per_unit<FromType, ToType>};
+    if (std::is_same_v<FromType, ToType> || n < reserve_hint_sample_threshold) {
+      return bound;
+    }
+    std::size_t units{};
+    for (std::size_t i = 0; i < n; i += reserve_hint_sample_stride) {
+      units += output_units_of<ToType>(first[i]);
+    }
+    std::size_t const estimate{units * reserve_hint_sample_stride};
+    return std::min(bound, estimate + estimate / 16);
+  }
+
+#if defined(__cpp_lib_ranges_reserve_hint)
+  // The reserve hint of a to_utf_view over base: the estimate above for
+  // contiguous code units, and otherwise the base's own hint scaled by the
+  // most each code unit can transcode to.
+  template <exposition_only_code_unit ToType, std::ranges::approximately_sized_range V>
+  constexpr std::size_t to_utf_reserve_hint(V& base) {
+    using from_type = std::remove_cv_t<std::ranges::range_value_t<V>>;
+    if constexpr (std::ranges::contiguous_range<V> && std::ranges::sized_range<V>) {
+      return estimated_transcoded_size<ToType>(std::ranges::data(base), std::ranges::size(base));
+    } else {
+      return static_cast<std::size_t>(std::ranges::reserve_hint(base)) * max_units_per_unit<from_type, ToType>;
+    }
+  }
+#endif
+
+  // Encode the code point c as one or more code units starting at out, and
+  // return the position one past the last code unit written.
+  template <exposition_only_code_unit ToType, class O>
+  constexpr O encode_code_point(char32_t c, O out) {
+    if constexpr (std::is_same_v<ToType, char32_t>) {
+      *out = c;
+      ++out;
+    } else if constexpr (std::is_same_v<ToType, char16_t>) {
+      if (c <= std::numeric_limits<char16_t>::max()) {
+        *out = static_cast<char16_t>(c);
+        ++out;
+      } else {
+        // From http://www.unicode.org/faq/utf_bom.html#utf16-4
+        const char32_t lead_offset = 0xD800 - (0x10000 >> 10);
+        *out = static_cast<char16_t>(lead_offset + (c >> 10));
+        ++out;
+        *out = static_cast<char16_t>(0xDC00 + (c & 0x3FF));
+        ++out;
+      }
+    } else {
+      int bits = std::bit_width(static_cast<std::uint32_t>(c));
+      if (bits <= 7) [[likely]] {
+        *out = static_cast<char8_t>(c);
+        ++out;
+        return out;
+      } else if (bits <= 11) {
+        *out = static_cast<char8_t>(0xC0 | (c >> 6));
+        ++out;
+      } else if (bits <= 16) {
+        *out = static_cast<char8_t>(0xE0 | (c >> 12));
+        ++out;
+        *out = static_cast<char8_t>(0x80 | ((c >> 6) & 0x3F));
+        ++out;
+      } else {
+        *out = static_cast<char8_t>(0xF0 | ((c >> 18) & 0x07));
+        ++out;
+        *out = static_cast<char8_t>(0x80 | ((c >> 12) & 0x3F));
+        ++out;
+        *out = static_cast<char8_t>(0x80 | ((c >> 6) & 0x3F));
+        ++out;
+      }
+      *out = static_cast<char8_t>(0x80 | (c & 0x3F));
+      ++out;
+    }
+    return out;
+  }
+
+  // The code units of a code point as encode_code_point_packed returns them:
+  // unit i occupies bits [i * w, (i + 1) * w) of units, where w is the width of
+  // a code unit in bits.
+  struct packed_code_units {
+    std::uint32_t units;
+    std::uint8_t length;
+  };
+
+  // Encode the code point c without branching on its length. The length comes
+  // from comparisons and every unit from shifts and masks of c, so text that
+  // mixes one- to four-unit code points has no branch to mispredict, and the
+  // caller can store all of the units at once.
+  template <exposition_only_code_unit ToType>
+  constexpr packed_code_units encode_code_point_packed(char32_t c) {
+    std::uint32_t const cp{c};
+    auto const length{static_cast<std::uint8_t>(encoded_length<ToType>(c))};
+    if constexpr (std::is_same_v<ToType, char32_t>) {
+      return {cp, length};
+    } else if constexpr (std::is_same_v<ToType, char16_t>) {
+      // From http://www.unicode.org/faq/utf_bom.html#utf16-4
+      std::uint32_t const lead{0xD800 - (0x10000 >> 10) + (cp >> 10)};
+      std::uint32_t const trail{0xDC00 + (cp & 0x3FF)};
+      return {length == 1 ? cp : lead | trail << 16, length};
+    } else {
+      // Spread the payload into six-bit groups, one per byte with the lead
+      // byte's bits most significant, add the lead and continuation markers
+      // for the length, then reverse so the lead byte is unit 0.
+      constexpr std::uint32_t markers[]{0, 0, 0xC080, 0xE08080, 0xF0808080};
+      std::uint32_t const spread{(cp & 0x3F) | (cp << 2 & 0x3F00) | (cp << 4 & 0x3F0000) |
+                                 (cp << 6 & 0x7000000)};
+      std::uint32_t const lead_first{length == 1 ? cp : spread | markers[length]};
+      return {std::byteswap(lead_first) >> (32 - 8 * length), length};
+    }
+  }
+
+  // Everything a to_utf_view iterator knows about the code point it is on,
+  // in eight bytes: the code units it encodes to, as encode_code_point_packed
+  // returns them, and a 32-bit word of one-byte fields, the index of the
+  // current code unit, the number of input code units after the code point
+  // known to be ASCII or, when the input is in the same encoding as the
+  // output, well-formed, the number of input code units it was decoded from,
+  // and the number of code units packed together with the error it was
+  // decoded with, if any. Each code unit is shifted out of the packed units
+  // when it is read, so there is no buffer to copy with the iterator.
+  template <exposition_only_code_unit ToType>
+  class packed_transcoding_state {
+    static constexpr int error_shift = 3;
+
+    std::uint32_t units_{};
+    std::int8_t index_{};
+    std::uint8_t run_{};
+    std::uint8_t to_increment_{};
+    std::uint8_t length_and_error_{};
+
+  public:
+    // Move to the code point c, decoded from to_incr input code units with
+    // the given outcome, at the first of its code units. The run is left as
+    // it is.
+    constexpr void assign(char32_t c, std::uint8_t to_incr, std::expected<void, utf_transcoding_error> success) {
+      packed_code_units const packed{encode_code_point_packed<ToType>(c)};
+      unsigned const error{success ? 0 : static_cast<unsigned>(success.error()) + 1};
+      units_ = packed.units;
+      index_ = 0;
+      to_increment_ = to_incr;
+      length_and_error_ = static_cast<std::uint8_t>(packed.length | error << error_shift);
+    }
+
+    // Move to a well-formed code point that is already encoded as ToType,
+    // as the length code units packed into units, at the first of them.
+    constexpr void assign_units(std::uint32_t units, std::uint8_t length) {
+      units_ = units;
+      index_ = 0;
+      to_increment_ = length;
+      length_and_error_ = length;
+    }
+
+    // The code unit at index().
+    constexpr ToType unit() const {
+      if constexpr (std::is_same_v<ToType, char32_t>) {
+        return static_cast<ToType>(units_);
+      } else {
+        return static_cast<ToType>(units_ >> (index_ * 8 * sizeof(ToType)));
+      }
+    }
+
+    // The number of code units the code point is encoded as.
+    constexpr std::int8_t length() const {
+      if constexpr (std::is_same_v<ToType, char32_t>) {
+        return 1;
+      } else {
+        return static_cast<std::int8_t>(length_and_error_ & ((1 << error_shift) - 1));
+      }
+    }
+
+    // The index of the current code unit, or -1 past the end of an input
+    // range.
+    constexpr std::int8_t index() const {
+      return index_;
+    }
+
+    constexpr void set_index(std::int8_t index) {
+      index_ = index;
+    }
+
+    constexpr std::uint8_t to_increment() const {
+      return to_increment_;
+    }
+
+    constexpr std::expected<void, utf_transcoding_error> success() const {
+      unsigned const error{static_cast<unsigned>(length_and_error_ >> error_shift)};
+      if (error) {
+        return std::unexpected{static_cast<utf_transcoding_error>(error - 1)};
+      }
+      return {};
+    }
+
+    constexpr std::uint8_t run() const {
+      return run_;
+    }
+
+    constexpr void set_run(std::uint8_t run) {
+      run_ = run;
+    }
+  };
+
+  static_assert(sizeof(packed_transcoding_state<char8_t>) == 8);
+  static_assert(sizeof(packed_transcoding_state<char16_t>) == 8);
+  static_assert(sizeof(packed_transcoding_state<char32_t>) == 8);
 
-using to_utf16_tag_t = to_utf_tag_t<char16_t>;
+  // Gives the bulk counting algorithms in utf_distance.hpp, where it is
+  // defined, access to the internals of to_utf_view's iterator.
+  struct to_utf_iterator_access;
 
-constexpr to_utf16_tag_t to_utf16_tag{};
+  // The error kind of I, an iterator of a to_utf_view.
+  template <class I>
+  struct to_utf_iterator_error_kind {
+    static constexpr to_utf_view_error_kind value = I::error_kind;
+  };
 
-using to_utf32_tag_t = to_utf_tag_t<char32_t>;
+} // namespace detail
 
-constexpr to_utf32_tag_t to_utf32_tag{};
+/* PAPER */
 
 template <std::ranges::input_range V, to_utf_view_error_kind E, exposition_only_code_unit ToType>
   requires std::ranges::view<V> && exposition_only_code_unit<std::ranges::range_value_t<V>>
@@ -226,11 +921,11 @@ public:
 #if defined(__cpp_lib_ranges_reserve_hint)
   /* PAPER:   constexpr auto reserve_hint() requires approximately_sized_range<V>; */
   constexpr auto reserve_hint() requires std::ranges::approximately_sized_range<V> {
-    return std::ranges::reserve_hint(base_);
+    return detail::to_utf_reserve_hint<ToType>(base_);
   }
   /* PAPER:   constexpr auto reserve_hint() const requires approximately_sized_range<const V>; */
-  constexpr auto reserve_hint() const requires std::ranges::approximately_sized_range<const V>; {
-    return std::ranges::reserve_hint(base_);
+  constexpr auto reserve_hint() const requires std::ranges::approximately_sized_range<const V> {
+    return detail::to_utf_reserve_hint<ToType>(base_);
   }
 #endif
   /* PAPER */
@@ -251,6 +946,8 @@ private:
 
 /* !PAPER */
   using from_type = std::ranges::range_value_t<V>; // @*exposition only*@
+  using to_type = ToType;
+  static constexpr to_utf_view_error_kind error_kind = E;
 
   static consteval auto iter_concept_impl() {
     if constexpr (std::ranges::bidirectional_range<exposition_only_Base>) {
@@ -292,21 +989,50 @@ public: // MSVC has some bug with their implementation of friendship
   [[no_unique_address]] std::ranges::sentinel_t<exposition_only_Base> end_{}; // @*exposition only*@
 /* PAPER:   sentinel_t<exposition_only_Base> end_; // @*exposition only*@ */
 
-  detail::fake_inplace_vector<value_type, 4 / sizeof(ToType)> buf_{}; // @*exposition only*@
 /* PAPER:   inplace_vector<value_type, 4 / sizeof(ToType)> buf_{}; // @*exposition only*@ */
-/* PAPER */
-
-  std::int8_t buf_index_{}; // @*exposition only*@
-  std::uint8_t to_increment_{}; // @*exposition only*@
-
-  /* !PAPER */
-  std::expected<void, utf_transcoding_error> success_{};
+/* PAPER: */
+/* PAPER:   int8_t buf_index_{}; // @*exposition only*@ */
+/* PAPER:   uint8_t to_increment_{}; // @*exposition only*@ */
+/* PAPER: */
+
+  // Stands in for buf_, buf_index_ and to_increment_, along with whether the
+  // current code point was decoded successfully and the run state below, so
+  // that the iterator is its base iterators plus eight bytes.
+  detail::packed_transcoding_state<ToType> state_{};
+
+  // Whether the input can be scanned a block at a time, which requires it to
+  // be in contiguous memory of known extent, or to be as_charN_t over integers
+  // that are.
+  static constexpr bool contiguous_input =
+      (std::ranges::contiguous_range<exposition_only_Base> ||
+       detail::contiguous_code_unit_cast_view<exposition_only_Base>) &&
+      std::sized_sentinel_for<std::ranges::sentinel_t<exposition_only_Base>,
+                              std::ranges::iterator_t<exposition_only_Base>>;
+
+  // Whether well-formed runs of input in the same encoding as the output are
+  // found a block at a time with the vectorized validators, and their code
+  // units read as they are rather than decoded and encoded again. UTF-32 is
+  // left to the decoder, for which it is a single comparison anyway.
+  static constexpr bool valid_runs = std::is_same_v<from_type, ToType> && !std::is_same_v<from_type, char32_t> &&
+      E != to_utf_view_error_kind::assume_valid && contiguous_input;
+
+  // Otherwise, whether runs of ASCII UTF-8 are found a block at a time.
+  static constexpr bool ascii_runs = std::is_same_v<from_type, char8_t> && !valid_runs && contiguous_input;
+
+  // The longest run looked for at once. Runs are found lazily, so this
+  // bounds the work done ahead of what has actually been iterated over.
+  static constexpr std::ptrdiff_t max_run = 64;
 
   /* PAPER */
 
   template <std::ranges::input_range V2, to_utf_view_error_kind E2, exposition_only_code_unit ToType2>
     requires std::ranges::view<V2> && exposition_only_code_unit<std::ranges::range_value_t<V2>>
   friend class to_utf_view; // @*exposition only*@
+  /* !PAPER */
+  friend struct detail::to_utf_iterator_access;
+  template <class I>
+  friend struct detail::to_utf_iterator_error_kind;
+  /* PAPER */
 
 public:
   constexpr exposition_only_iterator()
@@ -344,7 +1070,10 @@ private:
     if (current_ != exposition_only_end())
       exposition_only_read();
     else if constexpr (!std::ranges::forward_range<exposition_only_Base>) {
-      buf_index_ = -1;
+      /* !PAPER */
+      state_.set_index(-1);
+      /* PAPER */
+      /* PAPER:       buf_index_ = -1; */
     }
   }
 
@@ -366,11 +1095,12 @@ public:
   /* !PAPER */
   constexpr value_type operator*() const {
     if constexpr (E == to_utf_view_error_kind::expected) {
-      if (!success_.has_value()) {
-        return std::unexpected{success_.error()};
+      std::expected<void, utf_transcoding_error> const success{state_.success()};
+      if (!success) {
+        return std::unexpected{success.error()};
       }
     }
-    return buf_[buf_index_];
+    return state_.unit();
   }
   /* PAPER */
 
@@ -378,7 +1108,7 @@ public:
   {
     if (!exposition_only_success()) {
       /* !PAPER */
-      assert(buf_index_ == 0);
+      assert(state_.index() == 0);
       /* PAPER */
       if constexpr (std::is_same_v<ToType, char8_t>) {
         exposition_only_advance_one();
@@ -389,7 +1119,10 @@ public:
     return *this;
   }
 
-  constexpr exposition_only_iterator& operator++() requires(E == to_utf_view_error_kind::replacement)
+  /* !PAPER */
+  constexpr exposition_only_iterator& operator++() requires(E != to_utf_view_error_kind::expected)
+  /* PAPER */
+  /* PAPER:   constexpr @*iterator*@& operator++() requires(E == to_utf_view_error_kind::replacement) */
   {
     exposition_only_advance_one();
     return *this;
@@ -408,10 +1141,16 @@ public:
   constexpr exposition_only_iterator& operator--()
     requires std::ranges::bidirectional_range<exposition_only_Base>
   {
-    if (!buf_index_)
+    /* !PAPER */
+    if (!state_.index())
       exposition_only_read_reverse();
     else
-      --buf_index_;
+      state_.set_index(state_.index() - 1);
+    /* PAPER */
+    /* PAPER:     if (!buf_index_) */
+    /* PAPER:       exposition_only_read_reverse(); */
+    /* PAPER:     else */
+    /* PAPER:       --buf_index_; */
     return *this;
   }
 
@@ -427,17 +1166,16 @@ public:
                                    const exposition_only_iterator& rhs)
     requires std::equality_comparable<std::ranges::iterator_t<exposition_only_Base>>
   {
-    return lhs.current_ == rhs.current_ && lhs.buf_index_ == rhs.buf_index_;
+    /* !PAPER */
+    return lhs.current_ == rhs.current_ && lhs.state_.index() == rhs.state_.index();
+    /* PAPER */
+    /* PAPER:     return lhs.current_ == rhs.current_ && lhs.buf_index_ == rhs.buf_index_; */
   }
 
 private:
   /* !PAPER */
 
-  struct decode_code_point_result {
-    char32_t c;
-    std::uint8_t to_incr;
-    std::expected<void, utf_transcoding_error> success;
-  };
+  using decode_code_point_result = detail::decode_code_point_result;
 
   template <class>
   struct guard {
@@ -472,246 +1210,81 @@ private:
   constexpr bool exposition_only_success() const noexcept // @*exposition only*@
     requires(E == to_utf_view_error_kind::expected)
   {
-    return !!success_;
+    return state_.success().has_value();
   }
 
   /* PAPER */
 
   constexpr void exposition_only_advance_one() // @*exposition only*@
   {
-    ++buf_index_;
     /* !PAPER */
-    if (buf_index_ == static_cast<std::int8_t>(buf_.size())) {
-    /* PAPER */
-    /* PAPER:     if (buf_index_ == buf_.size()) { */
+    if constexpr (ascii_runs) {
+      if (state_.run()) {
+        ++current_;
+        read_ascii_unit();
+        return;
+      }
+    } else if constexpr (valid_runs) {
+      if (state_.run() && state_.index() + 1 == state_.length()) {
+        current_ += state_.length();
+        read_valid_unit();
+        return;
+      }
+    }
+    std::int8_t const index = state_.index() + 1;
+    state_.set_index(index);
+    if (index == state_.length()) {
       if constexpr (std::ranges::forward_range<exposition_only_Base>) {
-        buf_index_ = 0;
-        std::advance(current_, to_increment_);
+        state_.set_index(0);
+        std::advance(current_, state_.to_increment());
       }
       if (current_ != exposition_only_end()) {
         exposition_only_read();
       } else if constexpr (!std::ranges::forward_range<exposition_only_Base>) {
-        buf_index_ = -1;
+        state_.set_index(-1);
       }
     }
+    /* PAPER */
+    /* PAPER:     ++buf_index_; */
+    /* PAPER:     if (buf_index_ == buf_.size()) { */
+    /* PAPER:       if constexpr (forward_range<exposition_only_Base>) { */
+    /* PAPER:         buf_index_ = 0; */
+    /* PAPER:         advance(current_, to_increment_); */
+    /* PAPER:       } */
+    /* PAPER:       if (current_ != exposition_only_end()) { */
+    /* PAPER:         exposition_only_read(); */
+    /* PAPER:       } else if constexpr (!forward_range<exposition_only_Base>) { */
+    /* PAPER:         buf_index_ = -1; */
+    /* PAPER:       } */
+    /* PAPER:     } */
   }
 
   /* !PAPER */
 
-  static constexpr decode_code_point_result decode_code_point_utf8_impl(
-      std::ranges::iterator_t<exposition_only_Base>& it, std::ranges::sentinel_t<exposition_only_Base> const& last) {
-    char32_t c{};
-    std::uint8_t u = *it;
-    ++it;
-    const std::uint8_t lo_bound = 0x80, hi_bound = 0xBF;
-    std::uint8_t to_incr = 1;
-    std::expected<void, utf_transcoding_error> success{};
-
-    auto const error{[&](utf_transcoding_error const error_enum_in) {
-      success = std::unexpected{error_enum_in};
-      c = U'\uFFFD';
-    }};
-
-    if (u <= 0x7F) [[likely]] // 0x00 to 0x7F
-      c = u;
-    else if (u < 0xC0) [[unlikely]] {
-      error(utf_transcoding_error::unexpected_utf8_continuation_byte);
-    } else if (u < 0xC2 || u > 0xF4) [[unlikely]] {
-      error(utf_transcoding_error::invalid_utf8_leading_byte);
-    } else if (it == last) [[unlikely]] {
-      error(utf_transcoding_error::truncated_utf8_sequence);
-    } else if (u <= 0xDF) // 0xC2 to 0xDF
-    {
-      c = u & 0x1F;
-      u = *it;
-
-      if (u < lo_bound || u > hi_bound) [[unlikely]]
-        error(utf_transcoding_error::truncated_utf8_sequence);
-      else {
-        c = (c << 6) | (u & 0x3F);
-        ++it;
-        ++to_incr;
-      }
-    } else if (u <= 0xEF) // 0xE0 to 0xEF
-    {
-      std::uint8_t orig = u;
-      c = u & 0x0F;
-      u = *it;
-
-      if (orig == 0xE0 && 0x80 <= u && u < 0xA0) [[unlikely]]
-        error(utf_transcoding_error::overlong);
-      else if (orig == 0xED && 0xA0 <= u && u < 0xC0) [[unlikely]]
-        error(utf_transcoding_error::encoded_surrogate);
-      else if (u < lo_bound || u > hi_bound) [[unlikely]]
-        error(utf_transcoding_error::truncated_utf8_sequence);
-      else if (++it == last) {
-        [[unlikely]]++ to_incr;
-        error(utf_transcoding_error::truncated_utf8_sequence);
-      } else {
-        ++to_incr;
-        c = (c << 6) | (u & 0x3F);
-        u = *it;
-
-        if (u < lo_bound || u > hi_bound) [[unlikely]]
-          error(utf_transcoding_error::truncated_utf8_sequence);
-        else {
-          c = (c << 6) | (u & 0x3F);
-          ++it;
-          ++to_incr;
-        }
-      }
-    } else if (u <= 0xF4) // 0xF0 to 0xF4
-    {
-      std::uint8_t orig = u;
-      c = u & 0x07;
-      u = *it;
-
-      if (orig == 0xF0 && 0x80 <= u && u < 0x90) [[unlikely]]
-        error(utf_transcoding_error::overlong);
-      else if (orig == 0xF4 && 0x90 <= u && u < 0xC0) [[unlikely]]
-        error(utf_transcoding_error::out_of_range);
-      else if (u < lo_bound || u > hi_bound) [[unlikely]]
-        error(utf_transcoding_error::truncated_utf8_sequence);
-      else if (++it == last) {
-        [[unlikely]]++ to_incr;
-        error(utf_transcoding_error::truncated_utf8_sequence);
-      } else {
-        ++to_incr;
-        c = (c << 6) | (u & 0x3F);
-        u = *it;
-
-        if (u < lo_bound || u > hi_bound) [[unlikely]]
-          error(utf_transcoding_error::truncated_utf8_sequence);
-        else if (++it == last) {
-          [[unlikely]]++ to_incr;
-          error(utf_transcoding_error::truncated_utf8_sequence);
-        } else {
-          ++to_incr;
-          c = (c << 6) | (u & 0x3F);
-          u = *it;
-
-          if (u < lo_bound || u > hi_bound) [[unlikely]]
-            error(utf_transcoding_error::truncated_utf8_sequence);
-          else {
-            c = (c << 6) | (u & 0x3F);
-            ++it;
-            ++to_incr;
-          }
-        }
-      }
-    }
-
-    return {.c{c}, .to_incr{to_incr}, .success{success}};
-  }
-
   constexpr decode_code_point_result decode_code_point_utf8() {
     guard<std::ranges::iterator_t<exposition_only_Base>> g{current_, current_};
-    return decode_code_point_utf8_impl(current_, exposition_only_end());
-  }
-
-  static constexpr decode_code_point_result decode_code_point_utf16_impl(
-      std::ranges::iterator_t<exposition_only_Base>& it, std::ranges::sentinel_t<exposition_only_Base> const& last) {
-    char32_t c{};
-    std::uint16_t u = *it;
-    ++it;
-    std::uint8_t to_incr = 1;
-    std::expected<void, utf_transcoding_error> success{};
-
-    auto const error{[&](utf_transcoding_error const error_enum_in) {
-      success = std::unexpected{error_enum_in};
-      c = U'\uFFFD';
-    }};
-
-    if (u < 0xD800 || u > 0xDFFF) [[likely]]
-      c = u;
-    else if (u < 0xDC00) {
-      if (it == last) [[unlikely]] {
-        error(utf_transcoding_error::unpaired_high_surrogate);
-      } else {
-        std::uint16_t u2 = *it;
-        if (u2 < 0xDC00 || u2 > 0xDFFF) [[unlikely]]
-          error(utf_transcoding_error::unpaired_high_surrogate);
-        else {
-          ++it;
-          to_incr = 2;
-          std::uint32_t x = (u & 0x3F) << 10 | (u2 & 0x3FF);
-          std::uint32_t w = (u >> 6) & 0x1F;
-          c = (w + 1) << 16 | x;
-        }
-      }
-    } else
-      error(utf_transcoding_error::unpaired_low_surrogate);
-
-    return {.c{c}, .to_incr{to_incr}, .success{success}};
+    if constexpr (E == to_utf_view_error_kind::assume_valid) {
+      return detail::decode_code_point_utf8_unchecked_impl(current_, exposition_only_end());
+    } else {
+      return detail::decode_code_point_utf8_impl(current_, exposition_only_end());
+    }
   }
 
   constexpr decode_code_point_result decode_code_point_utf16() {
     guard<std::ranges::iterator_t<exposition_only_Base>> g{current_, current_};
-    return decode_code_point_utf16_impl(current_, exposition_only_end());
-  }
-
-  static constexpr decode_code_point_result decode_code_point_utf32_impl(
-      std::ranges::iterator_t<exposition_only_Base>& it) {
-    char32_t c = *it;
-    std::expected<void, utf_transcoding_error> success{};
-    ++it;
-    auto const error{[&](utf_transcoding_error const error_enum_in) {
-      success = std::unexpected{error_enum_in};
-      c = U'\uFFFD';
-    }};
-    if (c >= 0xD800) {
-      if (c < 0xE000) {
-        error(utf_transcoding_error::encoded_surrogate);
-      }
-      if (c > 0x10FFFF) {
-        error(utf_transcoding_error::out_of_range);
-      }
+    if constexpr (E == to_utf_view_error_kind::assume_valid) {
+      return detail::decode_code_point_utf16_unchecked_impl(current_, exposition_only_end());
+    } else {
+      return detail::decode_code_point_utf16_impl(current_, exposition_only_end());
     }
-    return {.c{c}, .to_incr{1}, .success{success}};
   }
 
   constexpr decode_code_point_result decode_code_point_utf32() {
     guard<std::ranges::iterator_t<exposition_only_Base>> g{current_, current_};
-    return decode_code_point_utf32_impl(current_);
-  }
-
-  // Encode the code point c as one or more code units in buf.
-  constexpr void update(char32_t c, std::uint8_t to_incr) {
-    to_increment_ = to_incr;
-    buf_index_ = 0;
-    buf_.clear();
-    if constexpr (std::is_same_v<ToType, char32_t>) {
-      buf_.push_back(c);
-    } else if constexpr (std::is_same_v<ToType, char16_t>) {
-      if (c <= std::numeric_limits<char16_t>::max()) {
-        buf_.push_back(static_cast<char16_t>(c));
-      } else {
-        // From http://www.unicode.org/faq/utf_bom.html#utf16-4
-        const char32_t lead_offset = 0xD800 - (0x10000 >> 10);
-        char16_t lead = lead_offset + (c >> 10);
-        char16_t trail = 0xDC00 + (c & 0x3FF);
-        buf_.push_back(lead);
-        buf_.push_back(trail);
-      }
-    } else if constexpr (std::is_same_v<ToType, char8_t>) {
-      int bits = std::bit_width(static_cast<std::uint32_t>(c));
-      if (bits <= 7) [[likely]] {
-        buf_.push_back(static_cast<char8_t>(c));
-      } else if (bits <= 11) {
-        buf_.push_back(0xC0 | (c >> 6));
-        buf_.push_back(0x80 | (c & 0x3F));
-      } else if (bits <= 16) {
-        buf_.push_back(0xE0 | (c >> 12));
-        buf_.push_back(0x80 | ((c >> 6) & 0x3F));
-        buf_.push_back(0x80 | (c & 0x3F));
-      } else {
-        buf_.push_back(0xF0 | ((c >> 18) & 0x07));
-        buf_.push_back(0x80 | ((c >> 12) & 0x3F));
-        buf_.push_back(0x80 | ((c >> 6) & 0x3F));
-        buf_.push_back(0x80 | (c & 0x3F));
-      }
+    if constexpr (E == to_utf_view_error_kind::assume_valid) {
+      return detail::decode_code_point_utf32_unchecked_impl(current_);
     } else {
-      static_assert(false);
+      return detail::decode_code_point_utf32_impl(current_);
     }
   }
 
@@ -719,7 +1292,15 @@ private:
   /* PAPER: */
 
   constexpr void exposition_only_read() { // @*exposition only*@
-    success_.emplace();
+    if constexpr (ascii_runs) {
+      if (read_ascii()) {
+        return;
+      }
+    } else if constexpr (valid_runs) {
+      if (read_valid()) {
+        return;
+      }
+    }
     decode_code_point_result decode_result{};
     if constexpr (std::is_same_v<from_type, char8_t>)
       decode_result = decode_code_point_utf8();
@@ -730,8 +1311,92 @@ private:
     } else {
       static_assert(false);
     }
-    update(decode_result.c, decode_result.to_incr);
-    success_ = decode_result.success;
+    state_.assign(decode_result.c, decode_result.to_incr, decode_result.success);
+  }
+
+  // Read the code unit at current_ without going through the decoder if it is
+  // part of an ASCII run. Returns false if it is not ASCII.
+  constexpr bool read_ascii()
+    requires ascii_runs
+  {
+    if (!state_.run()) {
+      if (!detail::is_ascii(*current_)) {
+        return false;
+      }
+      state_.set_run(static_cast<std::uint8_t>(scan_run([](char8_t const* first, char8_t const* last) {
+        return detail::ascii_prefix_length(first, last);
+      })));
+    }
+    read_ascii_unit();
+    return true;
+  }
+
+  // While the ASCII run is nonempty, the current code point is the single
+  // code unit at current_, so moving to the next one needs no decoding at all.
+  constexpr void read_ascii_unit()
+    requires ascii_runs
+  {
+    state_.set_run(state_.run() - 1);
+    state_.assign(static_cast<char32_t>(*current_), 1, {});
+  }
+
+  // Read the code point at current_ without going through the decoder if it is
+  // part of a well-formed run. Returns false if the validators cannot vouch
+  // for it, which they can for any well-formed input given vector support.
+  constexpr bool read_valid()
+    requires valid_runs
+  {
+    if (!state_.run()) {
+      std::ptrdiff_t const run{scan_run([](from_type const* first, from_type const* last) {
+        return detail::valid_prefix(first, last) - first;
+      })};
+      if (!run) {
+        return false;
+      }
+      state_.set_run(static_cast<std::uint8_t>(run));
+    }
+    read_valid_unit();
+    return true;
+  }
+
+  // While the run is nonempty, the code point at current_ is well-formed and
+  // already in the output encoding, so its code units are taken as they are.
+  constexpr void read_valid_unit()
+    requires valid_runs
+  {
+    std::uint8_t length{1};
+    if constexpr (std::is_same_v<from_type, char8_t>) {
+      length = static_cast<std::uint8_t>(detail::utf8_code_units(*current_));
+    } else if (detail::high_surrogate(*current_)) {
+      length = 2;
+    }
+    std::uint32_t units{};
+    auto it{current_};
+    for (std::uint8_t i = 0; i != length; ++i, ++it) {
+      units |= static_cast<std::uint32_t>(*it) << (i * 8 * sizeof(from_type));
+    }
+    state_.set_run(static_cast<std::uint8_t>(state_.run() - length));
+    state_.assign_units(units, length);
+  }
+
+  // Apply scan(first, last) to as much of the input at current_ as a run may
+  // cover, returning the length of the run that it finds there.
+  template <class Scan>
+  constexpr std::ptrdiff_t scan_run(Scan scan) const
+    requires contiguous_input
+  {
+    std::ptrdiff_t const length{std::min(static_cast<std::ptrdiff_t>(exposition_only_end() - current_), max_run)};
+    if constexpr (std::ranges::contiguous_range<exposition_only_Base>) {
+      from_type const* const first = std::to_address(current_);
+      return static_cast<std::ptrdiff_t>(scan(first, first + length));
+    } else {
+      // Integers of another type are copied rather than read as code units
+      // in place, which the aliasing rules do not allow.
+      from_type units[max_run];
+      auto const* const first = std::to_address(current_.base());
+      std::ranges::copy(first, first + length, units);
+      return static_cast<std::ptrdiff_t>(scan(+units, units + length));
+    }
   }
 
   struct read_reverse_impl_result {
@@ -772,7 +1437,7 @@ private:
       } else {
         auto lead{it};
         decode_code_point_result const decode_result{
-            decode_code_point_utf8_impl(it, exposition_only_end())};
+            detail::decode_code_point_utf8_impl(it, exposition_only_end())};
         if (decode_result.success ||
             decode_result.success ==
                 std::unexpected{utf_transcoding_error::truncated_utf8_sequence}) {
@@ -832,7 +1497,7 @@ private:
         --it;
         if (detail::high_surrogate(*it)) {
           auto lead{it};
-          return {.decode_result{decode_code_point_utf16_impl(it, exposition_only_end())},
+          return {.decode_result{detail::decode_code_point_utf16_impl(it, exposition_only_end())},
                   .new_curr{lead}};
         } else {
           auto new_curr{orig};
@@ -857,13 +1522,15 @@ private:
     --it;
     auto new_curr{orig};
     --new_curr;
-    return {.decode_result{decode_code_point_utf32_impl(it)}, .new_curr{new_curr}};
+    return {.decode_result{detail::decode_code_point_utf32_impl(it)}, .new_curr{new_curr}};
   }
 
   /* PAPER:       constexpr void exposition_only_read_reverse(); // @*exposition only*@ */
 
   constexpr void exposition_only_read_reverse() { // @*exposition only*@
-    success_.emplace();
+    if constexpr (ascii_runs || valid_runs) {
+      state_.set_run(0);
+    }
     auto const read_reverse_impl_result{[&] {
       if constexpr (std::is_same_v<from_type, char8_t>) {
         return read_reverse_utf8();
@@ -873,15 +1540,14 @@ private:
         return read_reverse_utf32();
       }
     }()};
-    update(read_reverse_impl_result.decode_result.c,
-           read_reverse_impl_result.decode_result.to_incr);
-    success_ = read_reverse_impl_result.decode_result.success;
+    state_.assign(read_reverse_impl_result.decode_result.c,
+                  read_reverse_impl_result.decode_result.to_incr,
+                  read_reverse_impl_result.decode_result.success);
     current_ = read_reverse_impl_result.new_curr;
-    assert(buf_.size());
-    buf_index_ = buf_.size() - 1;
+    state_.set_index(state_.length() - 1);
     if constexpr (E == to_utf_view_error_kind::expected) {
-      if (!success_.has_value()) {
-        buf_index_ = 0;
+      if (!exposition_only_success()) {
+        state_.set_index(0);
       }
     }
   }
@@ -917,7 +1583,10 @@ public:
     if constexpr (std::ranges::forward_range<exposition_only_Base>) {
       return x.current_ == y.end_;
     } else {
-      return x.current_ == y.end_ && x.buf_index_ == -1;
+      /* !PAPER */
+      return x.current_ == y.end_ && x.state_.index() == -1;
+      /* PAPER */
+      /* PAPER:       return x.current_ == y.end_ && x.buf_index_ == -1; */
     }
   }
 };
@@ -932,6 +1601,17 @@ namespace detail {
   template <class R, auto E, class Tag>
   inline constexpr bool is_to_utf_view_v<to_utf_view<R, E, Tag>> = true;
 
+  // Specialized for validated_utf_view in validated_utf_view.hpp.
+  template <class T>
+  inline constexpr bool is_validated_utf_view_v = false;
+
+  // Whether T is a validated_utf_view, or to_utf views over one.
+  template <class T>
+  inline constexpr bool has_validated_source_v = is_validated_utf_view_v<T>;
+
+  template <class R, auto E, class Tag>
+  inline constexpr bool has_validated_source_v<to_utf_view<R, E, Tag>> = has_validated_source_v<R>;
+
   template <class T>
   inline constexpr bool is_to_utf_subrange_v = false;
 
@@ -939,6 +1619,29 @@ namespace detail {
   inline constexpr bool is_to_utf_subrange_v<std::ranges::subrange<I, I, std::ranges::subrange_kind::unsized>> =
     requires { typename I::is_to_utf_view_iterator; };
 
+  // from_big_endian(r) | as_char16_t and the like, when the byte order is
+  // not the native one.
+  template <class T>
+  inline constexpr bool is_byteswap_cast_view_v = false;
+
+  template <class V, class CharT>
+  inline constexpr bool is_byteswap_cast_view_v<beman::transform_view::transform_view<
+      beman::transform_view::transform_view<V, exposition_only_byteswap>, exposition_only_implicit_cast_to<CharT>>> =
+      true;
+
+  // The error kind of the view that an adaptor of kind E builds when it is
+  // applied to a to_utf view or subrange with iterators I, over the code
+  // units underneath them. Whatever assume_valid promises is about the
+  // output of that inner view, not its input, so the input keeps the inner
+  // view's checks, with errors replaced rather than reported so that the
+  // elements are still code units.
+  template <to_utf_view_error_kind E, class I>
+  inline constexpr to_utf_view_error_kind folded_error_kind = E != to_utf_view_error_kind::assume_valid
+      ? E
+      : to_utf_iterator_error_kind<I>::value == to_utf_view_error_kind::assume_valid
+      ? to_utf_view_error_kind::assume_valid
+      : to_utf_view_error_kind::replacement;
+
   template <to_utf_view_error_kind E, exposition_only_code_unit ToType>
   struct to_utf_impl : std::ranges::range_adaptor_closure<to_utf_impl<E, ToType>> {
     template <std::ranges::range R>
@@ -946,16 +1649,33 @@ namespace detail {
     constexpr auto operator()(R&& r) const {
       using T = std::remove_cvref_t<R>;
       if constexpr (detail::is_empty_view<T>) {
-        if constexpr (E == to_utf_view_error_kind::replacement) {
+        if constexpr (E != to_utf_view_error_kind::expected) {
           return std::ranges::empty_view<ToType>{};
         } else {
           return std::ranges::empty_view<std::expected<ToType, utf_transcoding_error>>{};
         }
+      } else if constexpr (detail::has_validated_source_v<T> && detail::is_to_utf_view_v<T>) {
+        // Going back through the adaptor lets validated | to_utf16 | to_utf8
+        // keep the assume_valid kind.
+        return (*this)(std::forward<R>(r).base());
       } else if constexpr (detail::is_to_utf_view_v<T>) {
-        return to_utf_view(std::forward<R>(r).base(), detail::cw<E>, to_utf_tag<ToType>);
+        return to_utf_view(std::forward<R>(r).base(),
+                           detail::cw<detail::folded_error_kind<E, std::ranges::iterator_t<T>>>,
+                           to_utf_tag<ToType>);
+      } else if constexpr (detail::is_validated_utf_view_v<T> && E != to_utf_view_error_kind::expected) {
+        return to_utf_view(
+            std::forward<R>(r), detail::cw<to_utf_view_error_kind::assume_valid>, to_utf_tag<ToType>);
       } else if constexpr (detail::is_to_utf_subrange_v<T>) {
         return to_utf_view(
             std::ranges::subrange(r.begin().base(), r.end().base()),
+            detail::cw<detail::folded_error_kind<E, std::ranges::iterator_t<T>>>,
+            to_utf_tag<ToType>);
+      } else if constexpr (detail::is_byteswap_cast_view_v<T>) {
+        // Swap and cast in one layer rather than two, which also lets
+        // transcode find the integers underneath.
+        return to_utf_view(
+            beman::transform_view::transform_view(
+                std::forward<R>(r).base().base(), byteswap_to<std::ranges::range_value_t<T>>{}),
             detail::cw<E>,
             to_utf_tag<ToType>);
       } else {
@@ -984,6 +1704,15 @@ inline constexpr detail::to_utf_impl<to_utf_view_error_kind::expected, char16_t>
 
 inline constexpr detail::to_utf_impl<to_utf_view_error_kind::expected, char32_t> to_utf32_or_error;
 
+template <exposition_only_code_unit ToType>
+inline constexpr detail::to_utf_impl<to_utf_view_error_kind::assume_valid, ToType> to_utf_assume_valid;
+
+inline constexpr detail::to_utf_impl<to_utf_view_error_kind::assume_valid, char8_t> to_utf8_assume_valid;
+
+inline constexpr detail::to_utf_impl<to_utf_view_error_kind::assume_valid, char16_t> to_utf16_assume_valid;
+
+inline constexpr detail::to_utf_impl<to_utf_view_error_kind::assume_valid, char32_t> to_utf32_assume_valid;
+
 /* PAPER: namespace views {                                     */
 /* PAPER:                                                       */
 /* PAPER:   template<@*code-unit-to*@ ToType>                   */
@@ -0,0 +1,482 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_TRANSCODE_HPP
+#define BEMAN_UTF_VIEW_TRANSCODE_HPP
+
+#include <beman/utf_view/config.hpp>
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#include <beman/utf_view/code_unit_view.hpp>
+#include <beman/utf_view/detail/concepts.hpp>
+#include <beman/utf_view/detail/simd.hpp>
+#include <beman/utf_view/endian_view.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/validate.hpp>
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <beman/transform_view/transform_view.hpp>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace beman::utf_view {
+
+// Eager counterparts of to_utf and to_utf_or_error. Rather than producing
+// one code unit per iterator operation, these decode the input in a tight
+// loop and write the output in blocks, which is considerably faster when the
+// whole result is wanted anyway.
+
+template <class I, class O>
+struct transcode_result {
+  [[no_unique_address]] I in;
+  [[no_unique_address]] O out;
+  std::optional<utf_transcoding_error> error;
+};
+
+namespace detail {
+
+  template <class R>
+  struct transcode_source_type {
+    using type = R;
+  };
+
+  template <class R>
+    requires is_to_utf_view_v<std::remove_cvref_t<R>>
+  struct transcode_source_type<R> {
+    using type = decltype(std::declval<R>().base());
+  };
+
+  // The range of code units that transcode actually reads; for a to_utf_view
+  // this is its base, just as the to_utf CPOs would elide it.
+  template <class R>
+  using transcode_source_t = typename transcode_source_type<R>::type;
+
+  template <class R>
+  concept transcodable_range = is_not_array_of_char<R> &&
+      (is_to_utf_view_v<std::remove_cvref_t<R>> ||
+       (std::ranges::input_range<R> && exposition_only_code_unit<std::ranges::range_value_t<R>>));
+
+  template <class R>
+  concept forward_transcodable_range =
+      transcodable_range<R> && std::ranges::forward_range<transcode_source_t<R>>;
+
+  template <class R>
+  struct transcode_in {};
+
+  template <std::ranges::range R>
+    requires (!is_to_utf_view_v<std::remove_cvref_t<R>>)
+  struct transcode_in<R> {
+    using type = std::ranges::borrowed_iterator_t<R>;
+  };
+
+  template <class R>
+    requires is_to_utf_view_v<std::remove_cvref_t<R>>
+  struct transcode_in<R> {
+    using type = std::conditional_t<std::ranges::borrowed_range<transcode_source_t<R>>,
+                                    std::ranges::iterator_t<transcode_source_t<R>>,
+                                    std::ranges::dangling>;
+  };
+
+  template <class R>
+  using transcode_in_t = typename transcode_in<R>::type;
+
+  template <class FromType, class ToType>
+  struct transcode_block_result {
+    FromType const* in;
+    ToType* out;
+    std::optional<utf_transcoding_error> error;
+  };
+
+  // Transcode [first, last) to the code units starting at out. If Bounded,
+  // stop once fewer than max_code_units<ToType> units remain before out_last.
+  // If E is expected, stop at the start of the first ill-formed subsequence.
+  //
+  // Well-formed input is its own transcoding into the same encoding, so then
+  // the runs that the vectorized validators vouch for are copied as they are,
+  // and only the code points between them are decoded, as in
+  // for_each_valid_run.
+  template <to_utf_view_error_kind E, exposition_only_code_unit ToType, bool Bounded, class FromType>
+  constexpr transcode_block_result<FromType, ToType> transcode_block(
+      FromType const* first, FromType const* last, ToType* out, [[maybe_unused]] ToType* out_last) {
+    std::optional<utf_transcoding_error> error;
+    [[maybe_unused]] int scalar{};
+    while (first != last) {
+      if constexpr (Bounded) {
+        if (out_last - out < static_cast<std::ptrdiff_t>(max_code_units<ToType>)) {
+          break;
+        }
+      }
+      if constexpr (std::same_as<FromType, ToType>) {
+        if (scalar) {
+          --scalar;
+        } else {
+          std::ptrdiff_t length{std::min(last - first, valid_run_slice_size / std::ptrdiff_t{sizeof(FromType)})};
+          if constexpr (Bounded) {
+            length = std::min(length, out_last - out);
+          }
+          FromType const* const run_last = valid_prefix(first, first + length);
+          if (run_last != first) {
+            out = std::ranges::copy(first, run_last, out).out;
+            first = run_last;
+            continue;
+          }
+        }
+      }
+      if (static_cast<std::uint32_t>(*first) < 0x80) [[likely]] {
+        if constexpr (std::same_as<FromType, char8_t>) {
+          std::ptrdiff_t length{last - first};
+          if constexpr (Bounded) {
+            length = std::min(length, out_last - out);
+          }
+          std::size_t const run{ascii_prefix_length(first, first + length)};
+          out = std::ranges::copy(first, first + run, out).out;
+          first += run;
+          continue;
+        }
+        *out = static_cast<ToType>(*first);
+        ++out;
+        ++first;
+        continue;
+      }
+      FromType const* const start = first;
+      decode_code_point_result const decode_result{decode_code_point_impl<FromType>(first, last)};
+      if (!decode_result.success) [[unlikely]] {
+        if constexpr (E == to_utf_view_error_kind::expected) {
+          return {.in{start}, .out{out}, .error{decode_result.success.error()}};
+        }
+        if (!error) {
+          error = decode_result.success.error();
+        }
+        if constexpr (std::same_as<FromType, ToType>) {
+          scalar = scalar_code_points_after_error;
+        }
+      }
+      out = encode_code_point<ToType>(decode_result.c, out);
+    }
+    return {.in{first}, .out{out}, .error{error}};
+  }
+
+  template <class R>
+  constexpr decltype(auto) transcode_source(R&& r) {
+    if constexpr (is_to_utf_view_v<std::remove_cvref_t<R>>) {
+      return std::forward<R>(r).base();
+    } else {
+      return std::forward<R>(r);
+    }
+  }
+
+  // The number of code units of output transcode_blocks produces at a time.
+  inline constexpr std::size_t transcode_block_size = 256;
+
+  // The number of code units transcode_blocks byteswaps or converts at a
+  // time.
+  inline constexpr std::size_t transcode_conversion_block_size = 1024;
+
+  // The views that read code units by swapping the bytes of the integers of
+  // another range: from_big_endian or from_little_endian in the non-native
+  // byte order, on its own over UTF-16 or UTF-32, or followed by as_char16_t
+  // or as_char32_t, either as two views or fused into one by to_utf.
+  template <class S>
+  struct byteswap_view_traits {};
+
+  template <class V>
+  struct byteswap_view_traits<beman::transform_view::transform_view<V, exposition_only_byteswap>> {
+    template <class S>
+    static constexpr V base(S const& s) {
+      return s.base();
+    }
+  };
+
+  template <class V, class CharT>
+  struct byteswap_view_traits<beman::transform_view::transform_view<V, byteswap_to<CharT>>> {
+    template <class S>
+    static constexpr V base(S const& s) {
+      return s.base();
+    }
+  };
+
+  template <class V, class CharT>
+  struct byteswap_view_traits<beman::transform_view::transform_view<
+      beman::transform_view::transform_view<V, exposition_only_byteswap>, exposition_only_implicit_cast_to<CharT>>> {
+    template <class S>
+    static constexpr V base(S const& s) {
+      return s.base().base();
+    }
+  };
+
+  template <class S>
+  using byteswap_view_base_t = decltype(byteswap_view_traits<S>::base(std::declval<S const&>()));
+
+  // A byteswapping view over contiguous integers of the same size as its
+  // code units, which transcode_blocks swaps a block at a time with
+  // byteswap_copy rather than one at a time through the view.
+  template <class S>
+  concept contiguous_byteswap_view =
+      requires { typename byteswap_view_base_t<S>; } &&
+      std::ranges::contiguous_range<byteswap_view_base_t<S> const> &&
+      std::ranges::sized_range<byteswap_view_base_t<S> const> &&
+      std::integral<std::ranges::range_value_t<byteswap_view_base_t<S>>> &&
+      sizeof(std::ranges::range_value_t<byteswap_view_base_t<S>>) == sizeof(std::ranges::range_value_t<S>) &&
+      (sizeof(std::ranges::range_value_t<S>) == 2 || sizeof(std::ranges::range_value_t<S>) == 4);
+
+  template <class I>
+  struct transcode_blocks_result {
+    I in;
+    std::optional<utf_transcoding_error> error;
+  };
+
+  // Transcode source to ToType a block at a time, handing each block of
+  // output to on_block(first, last). The in member of the result is where
+  // decoding stopped, which is the end of source unless E is expected.
+  //
+  // Contiguous input in the same encoding as the output is handed over in
+  // place wherever it is well-formed, so only the replacement characters and
+  // the code points around them pass through buf.
+  template <to_utf_view_error_kind E, exposition_only_code_unit ToType, class S, class OnBlock>
+  constexpr transcode_blocks_result<std::ranges::iterator_t<S>> transcode_blocks(S& source,
+                                                                                 OnBlock on_block) {
+    using from_type = std::remove_cv_t<std::ranges::range_value_t<S>>;
+    ToType buf[transcode_block_size];
+    std::optional<utf_transcoding_error> error;
+
+    if constexpr (std::ranges::contiguous_range<S> && std::ranges::sized_range<S> &&
+                  std::same_as<from_type, ToType>) {
+      from_type const* const data = std::ranges::data(source);
+      ToType* buf_out = buf;
+      auto const flush{[&] {
+        if (buf_out != buf) {
+          on_block(static_cast<ToType const*>(buf), static_cast<ToType const*>(buf_out));
+          buf_out = buf;
+        }
+      }};
+      from_type const* const in_last{for_each_valid_run(
+          data, data + std::ranges::size(source),
+          [&](from_type const* run_first, from_type const* run_last) {
+            flush();
+            on_block(run_first, run_last);
+          },
+          [&](from_type const*, decode_code_point_result const& decode_result) {
+            if (!decode_result.success) {
+              if constexpr (E == to_utf_view_error_kind::expected) {
+                error = decode_result.success.error();
+                return false;
+              }
+              if (!error) {
+                error = decode_result.success.error();
+              }
+            }
+            if (buf + transcode_block_size - buf_out < static_cast<std::ptrdiff_t>(max_code_units<ToType>)) {
+              flush();
+            }
+            buf_out = encode_code_point<ToType>(decode_result.c, buf_out);
+            return true;
+          })};
+      flush();
+      return {.in{std::ranges::begin(source) + (in_last - data)}, .error{error}};
+    } else if constexpr (std::ranges::contiguous_range<S> && std::ranges::sized_range<S>) {
+      from_type const* const data = std::ranges::data(source);
+      from_type const* const data_end = data + std::ranges::size(source);
+      from_type const* first = data;
+      while (first != data_end) {
+        auto const block_result{
+            transcode_block<E, ToType, true>(first, data_end, buf, buf + transcode_block_size)};
+        first = block_result.in;
+        on_block(static_cast<ToType const*>(buf), static_cast<ToType const*>(block_result.out));
+        if (block_result.error && !error) {
+          error = block_result.error;
+          if constexpr (E == to_utf_view_error_kind::expected) {
+            break;
+          }
+        }
+      }
+      return {.in{std::ranges::begin(source) + (first - data)}, .error{error}};
+    } else if constexpr (contiguous_byteswap_view<std::remove_cv_t<S>> || contiguous_code_unit_cast_view<S>) {
+      auto const base{[&] {
+        if constexpr (contiguous_code_unit_cast_view<S>) {
+          return source.base();
+        } else {
+          return byteswap_view_traits<std::remove_cv_t<S>>::base(source);
+        }
+      }()};
+      auto const* const data = std::ranges::data(base);
+      std::size_t const size{std::ranges::size(base)};
+      from_type units[transcode_conversion_block_size];
+      std::size_t position{};
+      while (position != size) {
+        std::size_t units_size{std::min(size - position, transcode_conversion_block_size)};
+        if constexpr (contiguous_code_unit_cast_view<S>) {
+          std::ranges::copy(data + position, data + position + units_size, units);
+        } else {
+          byteswap_copy(data + position, data + position + units_size, units);
+        }
+        // A sequence that the end of a block cuts short is left for the next
+        // one, which has the rest of it, if any.
+        if (position + units_size != size) {
+          if constexpr (std::same_as<from_type, char8_t>) {
+            for (std::size_t i = 1; i != max_code_units<char8_t>; ++i) {
+              if (!continuation(units[units_size - i])) {
+                if (utf8_code_units(units[units_size - i]) > static_cast<int>(i)) {
+                  units_size -= i;
+                }
+                break;
+              }
+            }
+          } else if constexpr (std::same_as<from_type, char16_t>) {
+            if (high_surrogate(units[units_size - 1])) {
+              --units_size;
+            }
+          }
+        }
+        from_type const* first = units;
+        from_type const* const last = units + units_size;
+        while (first != last) {
+          auto const block_result{
+              transcode_block<E, ToType, true>(first, last, buf, buf + transcode_block_size)};
+          first = block_result.in;
+          on_block(static_cast<ToType const*>(buf), static_cast<ToType const*>(block_result.out));
+          if (block_result.error && !error) {
+            error = block_result.error;
+            if constexpr (E == to_utf_view_error_kind::expected) {
+              return {.in{std::ranges::begin(source) +
+                          static_cast<std::ranges::range_difference_t<S>>(position + (first - units))},
+                      .error{error}};
+            }
+          }
+        }
+        position += units_size;
+      }
+      return {.in{std::ranges::begin(source) + static_cast<std::ranges::range_difference_t<S>>(size)},
+              .error{error}};
+    } else {
+      auto it = std::ranges::begin(source);
+      auto const last = std::ranges::end(source);
+      while (it != last) {
+        ToType* buf_out = buf;
+        while (it != last && buf + transcode_block_size - buf_out >=
+                                 static_cast<std::ptrdiff_t>(max_code_units<ToType>)) {
+          if constexpr (E == to_utf_view_error_kind::expected) {
+            auto const start = it;
+            decode_code_point_result const decode_result{decode_code_point_impl<from_type>(it, last)};
+            if (!decode_result.success) {
+              it = start;
+              error = decode_result.success.error();
+              break;
+            }
+            buf_out = encode_code_point<ToType>(decode_result.c, buf_out);
+          } else {
+            decode_code_point_result const decode_result{decode_code_point_impl<from_type>(it, last)};
+            if (!decode_result.success && !error) {
+              error = decode_result.success.error();
+            }
+            buf_out = encode_code_point<ToType>(decode_result.c, buf_out);
+          }
+        }
+        on_block(static_cast<ToType const*>(buf), static_cast<ToType const*>(buf_out));
+        if constexpr (E == to_utf_view_error_kind::expected) {
+          if (error) {
+            break;
+          }
+        }
+      }
+      return {.in{std::move(it)}, .error{error}};
+    }
+  }
+
+  template <to_utf_view_error_kind E, exposition_only_code_unit ToType, class R, class O>
+  constexpr auto transcode_impl(R&& r, O out) {
+    using in_type = transcode_in_t<R>;
+    using result_type = transcode_result<in_type, O>;
+    decltype(auto) source = transcode_source(std::forward<R>(r));
+    using S = std::remove_reference_t<decltype(source)>;
+    using from_type = std::remove_cv_t<std::ranges::range_value_t<S>>;
+
+    auto const make_in{[&](auto it) -> in_type {
+      if constexpr (std::same_as<in_type, std::ranges::dangling>) {
+        return {};
+      } else {
+        return it;
+      }
+    }};
+
+    // Output of another value type, such as char for char8_t, is written
+    // through the blocks below, a code unit at a time.
+    if constexpr (std::ranges::contiguous_range<S> && std::ranges::sized_range<S> &&
+                  std::contiguous_iterator<O> && std::same_as<std::iter_value_t<O>, ToType>) {
+      from_type const* const data = std::ranges::data(source);
+      from_type const* const data_end = data + std::ranges::size(source);
+      ToType* const out_first = std::to_address(out);
+      auto const block_result{transcode_block<E, ToType, false>(data, data_end, out_first, out_first)};
+      return result_type{.in{make_in(std::ranges::begin(source) + (block_result.in - data))},
+                         .out{out + (block_result.out - out_first)},
+                         .error{block_result.error}};
+    } else {
+      auto blocks_result{transcode_blocks<E, ToType>(source, [&](ToType const* first, ToType const* last) {
+        out = std::ranges::copy(first, last, std::move(out)).out;
+      })};
+      return result_type{.in{make_in(std::move(blocks_result.in))},
+                         .out{std::move(out)},
+                         .error{blocks_result.error}};
+    }
+  }
+
+} // namespace detail
+
+// Transcodes all of r to ToType, writing the result to out. Ill-formed
+// subsequences are replaced with U+FFFD exactly as to_utf<ToType> would
+// replace them; error holds the first such error, if any.
+template <exposition_only_code_unit ToType, class R, std::weakly_incrementable O>
+  requires detail::transcodable_range<R> && std::indirectly_writable<O, ToType const&>
+constexpr transcode_result<detail::transcode_in_t<R>, O> transcode(R&& r, O out) {
+  return detail::transcode_impl<to_utf_view_error_kind::replacement, ToType>(
+      std::forward<R>(r), std::move(out));
+}
+
+template <class R, std::weakly_incrementable O>
+  requires detail::transcodable_range<R> && exposition_only_code_unit<std::iter_value_t<O>> &&
+           std::indirectly_writable<O, std::iter_value_t<O> const&>
+constexpr transcode_result<detail::transcode_in_t<R>, O> transcode(R&& r, O out) {
+  return detail::transcode_impl<to_utf_view_error_kind::replacement, std::iter_value_t<O>>(
+      std::forward<R>(r), std::move(out));
+}
+
+// Like transcode, but stops at the first ill-formed subsequence; in then
+// refers to its first code unit, and error says what was wrong with it.
+template <exposition_only_code_unit ToType, class R, std::weakly_incrementable O>
+  requires detail::forward_transcodable_range<R> && std::indirectly_writable<O, ToType const&>
+constexpr transcode_result<detail::transcode_in_t<R>, O> transcode_or_error(R&& r, O out) {
+  return detail::transcode_impl<to_utf_view_error_kind::expected, ToType>(
+      std::forward<R>(r), std::move(out));
+}
+
+template <class R, std::weakly_incrementable O>
+  requires detail::forward_transcodable_range<R> && exposition_only_code_unit<std::iter_value_t<O>> &&
+           std::indirectly_writable<O, std::iter_value_t<O> const&>
+constexpr transcode_result<detail::transcode_in_t<R>, O> transcode_or_error(R&& r, O out) {
+  return detail::transcode_impl<to_utf_view_error_kind::expected, std::iter_value_t<O>>(
+      std::forward<R>(r), std::move(out));
+}
+
+} // namespace beman::utf_view
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_TRANSCODE_HPP
@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_TRANSCODED_SIZE_HPP
+#define BEMAN_UTF_VIEW_TRANSCODED_SIZE_HPP
+
+#include <beman/utf_view/config.hpp>
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#include <beman/utf_view/detail/concepts.hpp>
+#include <beman/utf_view/detail/simd.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcode.hpp>
+#include <beman/utf_view/validate.hpp>
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace beman::utf_view {
+
+namespace detail {
+
+  // The number of ToType code units that well-formed [first, last) transcodes
+  // to, computed from counts of code unit classes rather than by decoding.
+  template <exposition_only_code_unit ToType>
+  constexpr std::size_t valid_transcoded_size(char8_t const* first, char8_t const* last) {
+    if constexpr (std::is_same_v<ToType, char8_t>) {
+      return static_cast<std::size_t>(last - first);
+    } else {
+      utf8_counts const counts{count_utf8(first, last)};
+      if constexpr (std::is_same_v<ToType, char16_t>) {
+        return counts.code_points + counts.four_byte_sequences;
+      } else {
+        return counts.code_points;
+      }
+    }
+  }
+
+  template <exposition_only_code_unit ToType>
+  constexpr std::size_t valid_transcoded_size(char16_t const* first, char16_t const* last) {
+    std::size_t const size{static_cast<std::size_t>(last - first)};
+    if constexpr (std::is_same_v<ToType, char16_t>) {
+      return size;
+    } else {
+      utf16_counts const counts{count_utf16(first, last)};
+      if constexpr (std::is_same_v<ToType, char32_t>) {
+        return size - counts.surrogate_pairs;
+      } else {
+        // Each surrogate counts as three bytes, but a pair only takes four.
+        return size + counts.above_7f + counts.above_7ff - 2 * counts.surrogate_pairs;
+      }
+    }
+  }
+
+  template <exposition_only_code_unit ToType>
+  constexpr std::size_t valid_transcoded_size(char32_t const* first, char32_t const* last) {
+    if constexpr (std::is_same_v<ToType, char32_t>) {
+      return static_cast<std::size_t>(last - first);
+    } else {
+      std::size_t size{};
+      for (; first != last; ++first) {
+        size += encoded_length<ToType>(*first);
+      }
+      return size;
+    }
+  }
+
+  template <to_utf_view_error_kind E, exposition_only_code_unit ToType, class R>
+  constexpr std::expected<std::size_t, utf_validation_error> transcoded_size_impl(R&& r) {
+    decltype(auto) source = transcode_source(std::forward<R>(r));
+    using S = std::remove_reference_t<decltype(source)>;
+    using from_type = std::remove_cv_t<std::ranges::range_value_t<S>>;
+    std::size_t size{};
+    std::optional<utf_validation_error> error;
+
+    if constexpr (std::ranges::contiguous_range<S> && std::ranges::sized_range<S>) {
+      from_type const* const first = std::ranges::data(source);
+      for_each_valid_run(
+          first, first + std::ranges::size(source),
+          [&](from_type const* run_first, from_type const* run_last) {
+            size += valid_transcoded_size<ToType>(run_first, run_last);
+          },
+          [&](from_type const* start, decode_code_point_result const& decode_result) {
+            if constexpr (E == to_utf_view_error_kind::expected) {
+              if (!decode_result.success) {
+                error = {.offset = static_cast<std::size_t>(start - first),
+                         .error = decode_result.success.error()};
+                return false;
+              }
+            }
+            size += encoded_length<ToType>(decode_result.c);
+            return true;
+          });
+    } else {
+      std::size_t offset{};
+      auto it = std::ranges::begin(source);
+      auto const last = std::ranges::end(source);
+      while (it != last) {
+        decode_code_point_result const decode_result{decode_code_point_impl<from_type>(it, last)};
+        if constexpr (E == to_utf_view_error_kind::expected) {
+          if (!decode_result.success) {
+            error = {.offset = offset, .error = decode_result.success.error()};
+            break;
+          }
+        }
+        offset += decode_result.to_incr;
+        size += encoded_length<ToType>(decode_result.c);
+      }
+    }
+
+    if (error) {
+      return std::unexpected{*error};
+    }
+    return size;
+  }
+
+} // namespace detail
+
+// The number of code units that r | to_utf<ToType> would produce, or that
+// transcode<ToType> would write. Well-formed input is measured by counting
+// lead bytes and surrogates, without decoding.
+template <exposition_only_code_unit ToType, class R>
+  requires detail::forward_transcodable_range<R>
+constexpr std::size_t transcoded_size(R&& r) {
+  return *detail::transcoded_size_impl<to_utf_view_error_kind::replacement, ToType>(
+      std::forward<R>(r));
+}
+
+// The number of code units that r | to_utf_or_error<ToType> would produce if r
+// is well-formed, and otherwise the position and kind of its first error.
+template <exposition_only_code_unit ToType, class R>
+  requires detail::forward_transcodable_range<R>
+constexpr std::expected<std::size_t, utf_validation_error> transcoded_size_or_error(R&& r) {
+  return detail::transcoded_size_impl<to_utf_view_error_kind::expected, ToType>(std::forward<R>(r));
+}
+
+} // namespace beman::utf_view
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_TRANSCODED_SIZE_HPP
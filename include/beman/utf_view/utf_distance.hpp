@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_UTF_DISTANCE_HPP
+#define BEMAN_UTF_VIEW_UTF_DISTANCE_HPP
+
+#include <beman/utf_view/config.hpp>
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#include <beman/utf_view/detail/concepts.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcoded_size.hpp>
+#include <beman/utf_view/validate.hpp>
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace beman::utf_view {
+
+namespace detail {
+
+  struct to_utf_iterator_access {
+    template <class I>
+    using to_type = typename I::to_type;
+
+    template <class I>
+    static constexpr to_utf_view_error_kind error_kind = I::error_kind;
+
+    template <class I>
+    static constexpr auto const& current(I const& it) {
+      return it.current_;
+    }
+
+    template <class I>
+    static constexpr auto const& end(I const& it) {
+      return it.end_;
+    }
+
+    // How many elements into the code point at current(it) it is.
+    template <class I>
+    static constexpr std::ptrdiff_t index(I const& it) {
+      return it.state_.index();
+    }
+
+    // An iterator over the same range as it, at the code point that starts
+    // at current.
+    template <class I, class Current>
+    static constexpr I at(I const& it, Current current) {
+      return I{it.begin_, std::move(current), it.end_};
+    }
+  };
+
+  template <class I>
+  using to_utf_iterator_current_t = std::remove_cvref_t<decltype(to_utf_iterator_access::current(std::declval<I>()))>;
+
+  template <class I>
+  using to_utf_iterator_end_t = std::remove_cvref_t<decltype(to_utf_iterator_access::end(std::declval<I>()))>;
+
+  // The iterators of to_utf_views whose base is contiguous and knows where it
+  // ends, so that the code units between two positions can be counted
+  // directly.
+  template <class I>
+  concept contiguous_to_utf_iterator = requires { typename I::is_to_utf_view_iterator; } &&
+      std::contiguous_iterator<to_utf_iterator_current_t<I>> &&
+      std::sized_sentinel_for<to_utf_iterator_end_t<I>, to_utf_iterator_current_t<I>>;
+
+  // The number of elements a to_utf_view produces for the code point that
+  // decode_result describes: its length in ToType, except that to_utf_or_error
+  // produces a single error in place of the code units of U+FFFD.
+  template <to_utf_view_error_kind E, exposition_only_code_unit ToType>
+  constexpr std::size_t code_point_elements(decode_code_point_result const& decode_result) {
+    if constexpr (E == to_utf_view_error_kind::expected) {
+      if (!decode_result.success) {
+        return 1;
+      }
+    }
+    return encoded_length<ToType>(decode_result.c);
+  }
+
+  // The number of elements a to_utf_view produces for [first, last), which
+  // starts and ends at code point boundaries. Well-formed runs are measured by
+  // counting lead bytes and surrogates.
+  template <to_utf_view_error_kind E, exposition_only_code_unit ToType, class FromType>
+  constexpr std::size_t utf_elements(FromType const* first, FromType const* last) {
+    if constexpr (E == to_utf_view_error_kind::assume_valid) {
+      return valid_transcoded_size<ToType>(first, last);
+    } else {
+      std::size_t size{};
+      for_each_valid_run(
+          first, last,
+          [&](FromType const* run_first, FromType const* run_last) {
+            size += valid_transcoded_size<ToType>(run_first, run_last);
+          },
+          [&](FromType const*, decode_code_point_result const& decode_result) {
+            size += code_point_elements<E, ToType>(decode_result);
+            return true;
+          });
+      return size;
+    }
+  }
+
+  // The most code units utf_skip validates and counts at once. A block whose
+  // elements do not all fit in what is left to skip is halved, down to
+  // utf_skip_min_block, below which code points are decoded one at a time.
+  // The block is never grown again: once it has been halved, what is left to
+  // skip is fewer elements than the rest of that block, so no larger block
+  // could fit.
+  template <class FromType>
+  inline constexpr std::ptrdiff_t utf_skip_block = 4096 / sizeof(FromType);
+
+  inline constexpr std::ptrdiff_t utf_skip_min_block = 16;
+
+  // Move p, a code point boundary, past as many whole code points of
+  // [p, last) as fit in n elements, and subtract their elements from n. What
+  // is left of n is less than the number of elements of the code point at
+  // the result, unless that is last.
+  template <to_utf_view_error_kind E, exposition_only_code_unit ToType, class FromType>
+  constexpr FromType const* utf_skip(FromType const* p, FromType const* last, std::size_t& n) {
+    constexpr int scalar_after_error = 64;
+    std::ptrdiff_t block{utf_skip_block<FromType>};
+    int scalar{};
+    while (n != 0 && p != last) {
+      if (scalar == 0 && block >= utf_skip_min_block && last - p >= utf_skip_min_block) {
+        FromType const* const block_last = code_point_boundary(p + std::min(last - p, block), last);
+        FromType const* const valid_last =
+            E == to_utf_view_error_kind::assume_valid ? block_last : valid_prefix(p, block_last);
+        if (valid_last != p) {
+          std::size_t const size{valid_transcoded_size<ToType>(p, valid_last)};
+          if (size <= n) {
+            n -= size;
+            p = valid_last;
+          } else {
+            block = (valid_last - p) / 2;
+          }
+          continue;
+        }
+        scalar = scalar_after_error;
+      }
+      FromType const* next = p;
+      std::size_t const size{code_point_elements<E, ToType>(decode_code_point_impl<FromType>(next, last))};
+      if (n < size) {
+        break;
+      }
+      n -= size;
+      p = next;
+      if (scalar != 0) {
+        --scalar;
+      }
+    }
+    return p;
+  }
+
+} // namespace detail
+
+// The number of elements from first to last, where last is an iterator or
+// the sentinel of the same to_utf_view. Well-formed stretches of the
+// underlying code units are measured by counting lead bytes or surrogates
+// rather than decoding them, which std::ranges::distance would do.
+template <class I, class S>
+  requires detail::contiguous_to_utf_iterator<I> && std::sentinel_for<S, I>
+constexpr std::iter_difference_t<I> utf_distance(I const& first, S const& last) {
+  using access = detail::to_utf_iterator_access;
+  auto const& first_current{access::current(first)};
+  std::ptrdiff_t last_index{};
+  std::ptrdiff_t units{};
+  if constexpr (std::same_as<S, I>) {
+    units = access::current(last) - first_current;
+    last_index = access::index(last);
+  } else {
+    units = last.base() - first_current;
+  }
+  auto const* const first_unit = std::to_address(first_current);
+  std::size_t const elements{
+      detail::utf_elements<access::error_kind<I>, access::to_type<I>>(first_unit, first_unit + units)};
+  return static_cast<std::iter_difference_t<I>>(elements) - access::index(first) + last_index;
+}
+
+// The number of elements of r, a to_utf_view over contiguous code units;
+// equivalent to std::ranges::distance(r).
+template <std::ranges::range R>
+  requires detail::is_to_utf_view_v<std::remove_cvref_t<R>> &&
+           detail::contiguous_to_utf_iterator<std::ranges::iterator_t<R>>
+constexpr std::ranges::range_difference_t<R> utf_distance(R&& r) {
+  return utf_distance(std::ranges::begin(r), std::ranges::end(r));
+}
+
+// Equivalent to std::ranges::advance(it, n), but for n >= 0 skips
+// well-formed stretches of the underlying code units a block at a time,
+// without decoding them. Moving backward decodes, as with std::ranges.
+template <class I>
+  requires detail::contiguous_to_utf_iterator<I>
+constexpr void utf_advance(I& it, std::iter_difference_t<I> n) {
+  using access = detail::to_utf_iterator_access;
+  if (n < 0) {
+    std::ranges::advance(it, n);
+    return;
+  }
+  for (; n != 0 && access::index(it) != 0; --n) {
+    ++it;
+  }
+  if (n == 0) {
+    return;
+  }
+  auto const& current{access::current(it)};
+  auto const* const first = std::to_address(current);
+  auto const* const last = first + (access::end(it) - current);
+  std::size_t remaining{static_cast<std::size_t>(n)};
+  auto const* const p = detail::utf_skip<access::error_kind<I>, access::to_type<I>>(first, last, remaining);
+  assert(p != last || remaining == 0);
+  if (p != first) {
+    it = access::at(it, current + (p - first));
+  }
+  for (; remaining != 0; --remaining) {
+    ++it;
+  }
+}
+
+// Equivalent to std::ranges::next(it, n), in the same way as utf_advance.
+template <class I>
+  requires detail::contiguous_to_utf_iterator<I>
+constexpr I utf_next(I it, std::iter_difference_t<I> n) {
+  utf_advance(it, n);
+  return it;
+}
+
+} // namespace beman::utf_view
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_UTF_DISTANCE_HPP
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_UTF_STREAM_TRANSCODER_HPP
+#define BEMAN_UTF_VIEW_UTF_STREAM_TRANSCODER_HPP
+
+#include <beman/utf_view/config.hpp>
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#include <beman/utf_view/detail/concepts.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcode.hpp>
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace beman::utf_view {
+
+namespace detail {
+
+  // The length of the longest suffix of [first, last) that is a proper
+  // prefix of a well-formed code unit sequence, and so might be completed by
+  // whatever follows last. Decoding from its first code unit consumes all of
+  // it only if every code unit after the first is one the decoder accepts.
+  template <class FromType>
+  constexpr std::size_t incomplete_suffix_length(FromType const* first, FromType const* last) {
+    if constexpr (std::same_as<FromType, char8_t>) {
+      FromType const* lead = last;
+      for (int i = 0; i != 3 && lead != first; ++i) {
+        --lead;
+        if (!continuation(*lead)) {
+          if (utf8_code_units(*lead) > last - lead) {
+            FromType const* it = lead;
+            decode_code_point_impl<FromType>(it, last);
+            if (it == last) {
+              return static_cast<std::size_t>(last - lead);
+            }
+          }
+          return 0;
+        }
+      }
+      return 0;
+    } else if constexpr (std::same_as<FromType, char16_t>) {
+      return first != last && high_surrogate(last[-1]) ? 1 : 0;
+    } else {
+      return 0;
+    }
+  }
+
+} // namespace detail
+
+// Transcodes input that arrives in pieces, such as the buffers read from a
+// socket or a pipe, without first gathering it into one range. Each call to
+// push transcodes a chunk, except for an incomplete code unit sequence at its
+// end, which is held back until the next chunk completes it or finish says
+// there is no more input. The concatenation of the output is what
+// to_utf<ToType> produces for the concatenation of the chunks, replacement
+// characters included.
+template <exposition_only_code_unit FromType, exposition_only_code_unit ToType>
+class utf_stream_transcoder {
+  static constexpr std::size_t max_pending = detail::max_code_units<FromType> - 1;
+
+  FromType pending_[detail::max_code_units<FromType>]{};
+  std::uint8_t pending_size_ = 0;
+  std::optional<utf_transcoding_error> error_;
+
+  template <class O>
+  constexpr O transcode_units(FromType const* first, FromType const* last, O out) {
+    auto result{transcode<ToType>(std::span<FromType const>{first, last}, std::move(out))};
+    if (result.error && !error_) {
+      error_ = result.error;
+    }
+    return std::move(result.out);
+  }
+
+public:
+  // The most code units that push can write for a chunk of size code units,
+  // or that finish can write for a size of 0.
+  static constexpr std::size_t max_output_size(std::size_t size) noexcept {
+    return (size + max_pending) * detail::max_code_units<ToType>;
+  }
+
+  template <std::weakly_incrementable O>
+    requires std::indirectly_writable<O, ToType const&>
+  constexpr O push(std::span<FromType const> chunk, O out) {
+    FromType const* first = chunk.data();
+    FromType const* const last = first + chunk.size();
+    if (pending_size_ != 0) {
+      // Finish the sequence that the previous chunk ended in the middle of,
+      // using as much of this chunk as it could possibly need.
+      FromType units[detail::max_code_units<FromType>];
+      std::size_t const taken{std::min(chunk.size(), detail::max_code_units<FromType> - pending_size_)};
+      FromType* const units_last =
+          std::ranges::copy(first, first + taken, std::ranges::copy(pending_, pending_ + pending_size_, units).out)
+              .out;
+      std::size_t const units_size{static_cast<std::size_t>(units_last - units)};
+      if (detail::incomplete_suffix_length<FromType>(units, units_last) == units_size) {
+        std::ranges::copy(units, units_last, pending_);
+        pending_size_ = static_cast<std::uint8_t>(units_size);
+        return out;
+      }
+      FromType const* it = units;
+      detail::decode_code_point_impl<FromType>(it, static_cast<FromType const*>(units_last));
+      out = transcode_units(units, it, std::move(out));
+      first += (it - units) - pending_size_;
+      pending_size_ = 0;
+    }
+    std::size_t const held{detail::incomplete_suffix_length(first, last)};
+    out = transcode_units(first, last - held, std::move(out));
+    std::ranges::copy(last - held, last, pending_);
+    pending_size_ = static_cast<std::uint8_t>(held);
+    return out;
+  }
+
+  // Transcodes what is held back from the last chunk, as the truncated
+  // sequence it is now known to be. The transcoder can then be reused for a
+  // new stream; error() still reports the first error of the previous one
+  // until reset.
+  template <std::weakly_incrementable O>
+    requires std::indirectly_writable<O, ToType const&>
+  constexpr O finish(O out) {
+    out = transcode_units(pending_, pending_ + pending_size_, std::move(out));
+    pending_size_ = 0;
+    return out;
+  }
+
+  constexpr void reset() noexcept {
+    pending_size_ = 0;
+    error_.reset();
+  }
+
+  // The number of code units held back from the last chunk.
+  constexpr std::size_t pending() const noexcept {
+    return pending_size_;
+  }
+
+  // The first ill-formed subsequence in the input so far, if any.
+  constexpr std::optional<utf_transcoding_error> error() const noexcept {
+    return error_;
+  }
+};
+
+} // namespace beman::utf_view
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_UTF_STREAM_TRANSCODER_HPP
@@ -2,6 +2,12 @@ module;
 
 #include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
 #include <cassert>
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
 
 export module beman.utf_view;
 
@@ -15,6 +21,7 @@ export {
 #include <beman/utf_view/detail/concepts.hpp>
 #include <beman/utf_view/detail/constant_wrapper_polyfill.hpp>
 #include <beman/utf_view/detail/fake_inplace_vector.hpp>
+#include <beman/utf_view/detail/simd.hpp>
 #include <beman/utf_view/utf_view.hpp>
 #pragma clang diagnostic pop
 }
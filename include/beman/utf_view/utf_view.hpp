@@ -14,8 +14,19 @@ import beman.utf_view;
 
 #include <beman/utf_view/code_unit_view.hpp>
 #include <beman/utf_view/endian_view.hpp>
+#include <beman/utf_view/for_each_chunk.hpp>
+#include <beman/utf_view/from_bom_view.hpp>
+#include <beman/utf_view/indexed_utf_view.hpp>
 #include <beman/utf_view/null_term.hpp>
+#include <beman/utf_view/sized_to_utf_view.hpp>
+#include <beman/utf_view/to_utf_readahead.hpp>
 #include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcode.hpp>
+#include <beman/utf_view/transcoded_size.hpp>
+#include <beman/utf_view/utf_distance.hpp>
+#include <beman/utf_view/utf_stream_transcoder.hpp>
+#include <beman/utf_view/validate.hpp>
+#include <beman/utf_view/validated_utf_view.hpp>
 
 #endif // BEMAN_UTF_VIEW_USE_MODULES() &&
        // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
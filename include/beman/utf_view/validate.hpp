@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_VALIDATE_HPP
+#define BEMAN_UTF_VIEW_VALIDATE_HPP
+
+#include <beman/utf_view/config.hpp>
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#include <beman/utf_view/detail/simd.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <ranges>
+#include <type_traits>
+#endif
+
+namespace beman::utf_view {
+
+// The first ill-formed subsequence of a range: offset is the index of its
+// first code unit, and error is what to_utf_or_error would report for it.
+struct utf_validation_error {
+  std::size_t offset;
+  utf_transcoding_error error;
+
+  friend constexpr bool operator==(utf_validation_error, utf_validation_error) = default;
+};
+
+namespace detail {
+
+  template <class R>
+  concept contiguous_utf8_range = std::ranges::contiguous_range<R> &&
+      std::ranges::sized_range<R> &&
+      std::same_as<std::remove_cv_t<std::ranges::range_value_t<R>>, char8_t>;
+
+  // The first position at or after p at which decoding would start a new
+  // subsequence. A lead byte consumes at most three continuation bytes, so
+  // even in a longer run of them the fourth is the start of one.
+  template <class FromType>
+  constexpr FromType const* code_point_boundary(FromType const* p, FromType const* last) {
+    if constexpr (std::same_as<FromType, char8_t>) {
+      for (int i = 0; i != 3 && p != last && continuation(*p); ++i) {
+        ++p;
+      }
+    } else if constexpr (std::same_as<FromType, char16_t>) {
+      if (p != last && low_surrogate(*p)) {
+        ++p;
+      }
+    }
+    return p;
+  }
+
+  // How much input for_each_valid_run validates at a time, in bytes, and how
+  // many code points after an error it leaves to the scalar decoder.
+  inline constexpr std::ptrdiff_t valid_run_slice_size = 16384;
+  inline constexpr int scalar_code_points_after_error = 64;
+
+  // Split [first, last) into runs that the vectorized validators vouch for,
+  // which are passed to on_valid(run_first, run_last), and the code points
+  // between them, which are decoded one at a time and passed to
+  // on_code_point(start, decode_result). If on_code_point returns false,
+  // stop and return its start; otherwise return last.
+  //
+  // The input is validated a slice at a time so that on_valid sees data that
+  // is still in cache. After an error the next few code points are decoded
+  // with the scalar decoder as well, since running the vector kernels on
+  // garbage would mean starting them over after every code point.
+  template <class FromType, class OnValid, class OnCodePoint>
+  constexpr FromType const* for_each_valid_run(FromType const* const first, FromType const* const last,
+                                               OnValid on_valid, OnCodePoint on_code_point) {
+    constexpr std::ptrdiff_t slice = valid_run_slice_size / sizeof(FromType);
+    FromType const* p = first;
+    while (p != last) {
+      FromType const* const run_last = valid_prefix(p, p + std::min(last - p, slice));
+      if (run_last != p) {
+        on_valid(p, run_last);
+        p = run_last;
+      }
+      for (int scalar = 1; p != last && scalar; --scalar) {
+        FromType const* const start = p;
+        decode_code_point_result const decode_result{decode_code_point_impl<FromType>(p, last)};
+        if (!on_code_point(start, decode_result)) {
+          return start;
+        }
+        if (!decode_result.success) {
+          scalar = scalar_code_points_after_error;
+        }
+      }
+    }
+    return last;
+  }
+
+  template <class FromType>
+  constexpr std::expected<void, utf_validation_error> validate_impl(FromType const* const first,
+                                                                    FromType const* const last) {
+    std::expected<void, utf_validation_error> result;
+    for_each_valid_run(
+        first, last, [](FromType const*, FromType const*) {},
+        [&](FromType const* start, decode_code_point_result const& decode_result) {
+          if (!decode_result.success) {
+            result = std::unexpected{
+                utf_validation_error{.offset = static_cast<std::size_t>(start - first),
+                                     .error = decode_result.success.error()}};
+            return false;
+          }
+          return true;
+        });
+    return result;
+  }
+
+} // namespace detail
+
+// Checks that r is well-formed UTF-8 without transcoding it. At run time this
+// uses the widest vector kernel that the CPU and operating system support,
+// chosen on first use and capped by the BEMAN_UTF_VIEW_SIMD environment
+// variable; during constant evaluation it uses the scalar one.
+template <class R>
+  requires detail::contiguous_utf8_range<R>
+constexpr std::expected<void, utf_validation_error> validate_utf8(R&& r) {
+  char8_t const* const first = std::ranges::data(r);
+  return detail::validate_impl(first, first + std::ranges::size(r));
+}
+
+} // namespace beman::utf_view
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_VALIDATE_HPP
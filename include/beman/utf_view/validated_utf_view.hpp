@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_VALIDATED_UTF_VIEW_HPP
+#define BEMAN_UTF_VIEW_VALIDATED_UTF_VIEW_HPP
+
+#include <beman/utf_view/config.hpp>
+
+#if BEMAN_UTF_VIEW_USE_MODULES() && \
+    !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+import beman.utf_view;
+
+#else
+
+#include <beman/utf_view/detail/concepts.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/validate.hpp>
+#if !BEMAN_UTF_VIEW_USE_MODULES()
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#endif
+
+namespace beman::utf_view {
+
+struct assume_valid_t {
+  explicit assume_valid_t() = default;
+};
+
+inline constexpr assume_valid_t assume_valid{};
+
+// A view of code units that are known to be well formed, because they were
+// checked by validate_utf or vouched for with assume_valid. Iterating over it
+// is iterating over V, but to_utf and the to_utfN adaptors recognize it and
+// transcode it without validating it again, as if with to_utf_assume_valid.
+// to_utf_or_error still checks, so that its element type does not change.
+template <std::ranges::view V>
+  requires exposition_only_code_unit<std::ranges::range_value_t<V>>
+class validated_utf_view : public std::ranges::view_interface<validated_utf_view<V>> {
+  V base_ = V();
+
+public:
+  validated_utf_view()
+    requires std::default_initializable<V>
+  = default;
+
+  // The caller vouches that base is well-formed UTF. If it is not,
+  // transcoding it is undefined behavior.
+  constexpr validated_utf_view(assume_valid_t, V base) : base_{std::move(base)} {}
+
+  constexpr V base() const&
+    requires std::copy_constructible<V>
+  {
+    return base_;
+  }
+
+  constexpr V base() && {
+    return std::move(base_);
+  }
+
+  constexpr auto begin() {
+    return std::ranges::begin(base_);
+  }
+
+  constexpr auto begin() const
+    requires std::ranges::range<V const>
+  {
+    return std::ranges::begin(base_);
+  }
+
+  constexpr auto end() {
+    return std::ranges::end(base_);
+  }
+
+  constexpr auto end() const
+    requires std::ranges::range<V const>
+  {
+    return std::ranges::end(base_);
+  }
+
+  constexpr auto size()
+    requires std::ranges::sized_range<V>
+  {
+    return std::ranges::size(base_);
+  }
+
+  constexpr auto size() const
+    requires std::ranges::sized_range<V const>
+  {
+    return std::ranges::size(base_);
+  }
+};
+
+namespace detail {
+
+  template <class V>
+  inline constexpr bool is_validated_utf_view_v<validated_utf_view<V>> = true;
+
+  template <std::ranges::forward_range R>
+  constexpr std::expected<void, utf_validation_error> validate_range_impl(R& r) {
+    using from_type = std::remove_cv_t<std::ranges::range_value_t<R>>;
+    std::size_t offset{};
+    auto it = std::ranges::begin(r);
+    auto const last = std::ranges::end(r);
+    while (it != last) {
+      decode_code_point_result const decode_result{decode_code_point_impl<from_type>(it, last)};
+      if (!decode_result.success) {
+        return std::unexpected{utf_validation_error{.offset = offset, .error = decode_result.success.error()}};
+      }
+      offset += decode_result.to_incr;
+    }
+    return {};
+  }
+
+} // namespace detail
+
+// Checks that r is well-formed UTF-8, UTF-16 or UTF-32, according to its
+// code unit type, and if it is, returns a view of it that records the fact.
+// Contiguous, sized input is checked with the vectorized validators.
+template <std::ranges::viewable_range R>
+  requires std::ranges::forward_range<R> && exposition_only_code_unit<std::ranges::range_value_t<R>> &&
+           detail::is_not_array_of_char<R>
+constexpr std::expected<validated_utf_view<std::views::all_t<R>>, utf_validation_error> validate_utf(R&& r) {
+  std::views::all_t<R> base{std::views::all(std::forward<R>(r))};
+  std::expected<void, utf_validation_error> result;
+  if constexpr (std::ranges::contiguous_range<std::views::all_t<R>> &&
+                std::ranges::sized_range<std::views::all_t<R>>) {
+    auto const first = std::ranges::data(base);
+    result = detail::validate_impl(first, first + std::ranges::size(base));
+  } else {
+    result = detail::validate_range_impl(base);
+  }
+  if (!result) {
+    return std::unexpected{result.error()};
+  }
+  return validated_utf_view<std::views::all_t<R>>{assume_valid, std::move(base)};
+}
+
+} // namespace beman::utf_view
+
+template <class V>
+inline constexpr bool std::ranges::enable_borrowed_range<beman::utf_view::validated_utf_view<V>> =
+    std::ranges::enable_borrowed_range<V>;
+
+#endif // BEMAN_UTF_VIEW_USE_MODULES() &&
+       // !defined(BEMAN_UTF_VIEW_INCLUDED_FROM_INTERFACE_UNIT)
+
+#endif // BEMAN_UTF_VIEW_VALIDATED_UTF_VIEW_HPP
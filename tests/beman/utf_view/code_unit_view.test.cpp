@@ -15,7 +15,9 @@ import std;
 #else
 #include <cstdint>
 #include <ranges>
+#include <string>
 #include <string_view>
+#include <type_traits>
 #endif
 
 namespace beman::utf_view::tests {
@@ -129,6 +131,20 @@ constexpr bool value_category_test() {
   return true;
 }
 
+// Casting code units to their own type leaves the range as it is, so that
+// it stays contiguous, but its elements still cannot be written through.
+constexpr bool identity_cast_test() {
+  std::u8string_view const foo{u8"foo"};
+  static_assert(std::is_same_v<decltype(foo | as_char8_t), std::u8string_view>);
+  std::u16string bar{u"bar"};
+  static_assert(std::ranges::contiguous_range<decltype(bar | as_char16_t)>);
+  static_assert(!std::is_assignable_v<std::ranges::range_reference_t<decltype(bar | as_char16_t)>, char16_t>);
+  static_assert(
+      !std::is_assignable_v<std::ranges::range_reference_t<decltype(std::u32string{} | as_char32_t)>, char32_t>);
+  static_assert(!std::ranges::contiguous_range<decltype(std::string_view{} | as_char8_t)>);
+  return (foo | as_char8_t).data() == foo.data() && (bar | as_char16_t).data() == bar.data();
+}
+
 CONSTEXPR_UNLESS_MSVC bool code_unit_view_test() {
   if (!smoke_test()) {
     return false;
@@ -139,6 +155,9 @@ CONSTEXPR_UNLESS_MSVC bool code_unit_view_test() {
   if (!value_category_test()) {
     return false;
   }
+  if (!identity_cast_test()) {
+    return false;
+  }
   return true;
 }
 
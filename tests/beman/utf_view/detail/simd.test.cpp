@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/detail/simd.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <framework.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+#endif
+
+namespace beman::utf_view::tests {
+
+namespace {
+
+  bool well_formed(std::u8string_view input) {
+    for (auto const c : input | to_utf32_or_error) {
+      if (!c) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Compare the kernels of table against the scalar ones on [first, last).
+  // The UTF-8 prefix kernels may stop at different places, so for those only
+  // check that the prefix is well-formed, and that the vector ones accept
+  // well-formed input in full.
+  bool kernels_agree(detail::kernel_table const& table, char8_t const* first, char8_t const* last) {
+    char8_t const* const prefix_end{table.utf8_valid_prefix(first, last)};
+    if (prefix_end < first || last < prefix_end || !well_formed({first, prefix_end}) ||
+        (table.isa != detail::simd_isa::scalar && well_formed({first, last}) && prefix_end != last)) {
+      return false;
+    }
+    detail::utf8_counts const counts{table.count_utf8(first, last)};
+    detail::utf8_counts const scalar_counts{detail::count_utf8_scalar(first, last)};
+    return table.ascii_prefix_length(first, last) == detail::ascii_prefix_length_scalar(first, last) &&
+        counts.code_points == scalar_counts.code_points &&
+        counts.four_byte_sequences == scalar_counts.four_byte_sequences;
+  }
+
+  bool kernels_agree(detail::kernel_table const& table, char16_t const* first, char16_t const* last) {
+    detail::utf16_counts const counts{table.count_utf16(first, last)};
+    detail::utf16_counts const scalar_counts{detail::count_utf16_scalar(first, last)};
+    return table.utf16_valid_prefix(first, last) == detail::utf16_valid_prefix_scalar(first, last) &&
+        counts.above_7f == scalar_counts.above_7f && counts.above_7ff == scalar_counts.above_7ff &&
+        counts.surrogate_pairs == scalar_counts.surrogate_pairs;
+  }
+
+  // Random slices of corrupted text, at every alignment and at lengths
+  // around each block size.
+  template <class CharT>
+  bool kernels_agree_on_corpus(detail::kernel_table const& table, std::basic_string<CharT> corpus,
+                               std::uint32_t corruption_min, std::uint32_t corruption_max) {
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<std::size_t> position{0, corpus.size() - 1};
+    std::uniform_int_distribution<std::uint32_t> corruption{corruption_min, corruption_max};
+    for (int round = 0; round != 200; ++round) {
+      std::basic_string<CharT> input{corpus};
+      for (int n = round % 4; n != 0; --n) {
+        input[position(rng)] = static_cast<CharT>(corruption(rng));
+      }
+      std::size_t const offset{position(rng) % 64};
+      std::size_t const length{std::min<std::size_t>(position(rng) % 300, input.size() - offset)};
+      if (!kernels_agree(table, input.data() + offset, input.data() + offset + length)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Compare the byteswap kernels of table against std::byteswap at every
+  // length up to 200 code units and at every alignment of a 64-byte block,
+  // copying and in place.
+  template <class T>
+  bool byteswap_kernels_agree(detail::kernel_table const& table) {
+    auto const kernel{sizeof(T) == 2 ? table.byteswap_16 : table.byteswap_32};
+    std::mt19937 rng{42};
+    std::vector<T> input(264);
+    for (T& unit : input) {
+      unit = static_cast<T>(rng());
+    }
+    for (std::size_t offset = 0; offset != 64 / sizeof(T); ++offset) {
+      for (std::size_t length = 0; length != 200; ++length) {
+        std::vector<T> expected(input);
+        std::vector<T> copied(input);
+        std::vector<T> in_place(input);
+        for (std::size_t i = offset; i != offset + length; ++i) {
+          expected[i] = std::byteswap(input[i]);
+        }
+        kernel(input.data() + offset, length, copied.data() + offset);
+        kernel(in_place.data() + offset, length, in_place.data() + offset);
+        if (copied != expected || in_place != expected) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+} // namespace
+
+bool simd_kernels_test() {
+  std::u32string text;
+  while (text.size() < 400) {
+    text += U"Qϕ学𡪇 ascii runs, العربية, 中文, \U0001F574\U0001F600.";
+  }
+  std::u8string const utf8{text | to_utf8 | std::ranges::to<std::u8string>()};
+  std::u16string const utf16{text | to_utf16 | std::ranges::to<std::u16string>()};
+
+  detail::simd_isa const supported{detail::supported_simd_isa()};
+  detail::kernel_table const* const previous{&detail::kernels()};
+  bool result{true};
+  for (detail::simd_isa const isa : {detail::simd_isa::scalar, detail::simd_isa::sse42,
+                                     detail::simd_isa::avx2, detail::simd_isa::avx512}) {
+    if (detail::use_simd_isa(isa) != std::min(isa, supported)) {
+      result = false;
+    }
+    detail::kernel_table const& table{detail::kernels()};
+    result = result && kernels_agree_on_corpus(table, utf8, 0x80, 0xFF) &&
+        kernels_agree_on_corpus(table, utf16, 0xD800, 0xDFFF) && byteswap_kernels_agree<std::uint16_t>(table) &&
+        byteswap_kernels_agree<std::uint32_t>(table);
+  }
+  detail::active_kernels.store(previous, std::memory_order_relaxed);
+  return result;
+}
+
+static auto const init{[] {
+  framework::tests().insert({"simd_kernels_test", &simd_kernels_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
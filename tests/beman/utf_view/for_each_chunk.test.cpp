@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
+#include <beman/utf_view/for_each_chunk.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <framework.hpp>
+#include <test_inputs.hpp>
+#include <test_iterators.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <cstddef>
+#include <expected>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+template <class V>
+constexpr bool chunks_match_elements(V view) {
+  using value_type = std::ranges::range_value_t<V>;
+  std::vector<value_type> const expected{view | std::ranges::to<std::vector<value_type>>()};
+  std::vector<value_type> chunked;
+  bool empty_chunk{};
+  for_each_chunk(view, [&](std::span<value_type const> chunk) {
+    empty_chunk = empty_chunk || chunk.empty();
+    chunked.insert(chunked.end(), chunk.begin(), chunk.end());
+  });
+  return !empty_chunk && chunked == expected;
+}
+
+template <exposition_only_code_unit FromType>
+constexpr bool chunks_match_elements_all(std::basic_string_view<FromType> input) {
+  auto forward_input{input | std::views::filter([](FromType) { return true; })};
+  return chunks_match_elements(input | to_utf8) && chunks_match_elements(input | to_utf16) &&
+      chunks_match_elements(input | to_utf32) && chunks_match_elements(input | to_utf8_or_error) &&
+      chunks_match_elements(input | to_utf16_or_error) &&
+      chunks_match_elements(input | to_utf32_or_error) &&
+      chunks_match_elements(forward_input | to_utf16) &&
+      chunks_match_elements(forward_input | to_utf8_or_error);
+}
+
+constexpr bool for_each_chunk_valid_test() {
+  return holds_for_valid_inputs([](auto input) { return chunks_match_elements_all(input); });
+}
+
+constexpr bool for_each_chunk_invalid_test() {
+  return holds_for_invalid_inputs([](auto input) { return chunks_match_elements_all(input); });
+}
+
+constexpr bool for_each_chunk_block_test() {
+  std::u8string input;
+  for (int i = 0; i != 200; ++i) {
+    input += u8"aé人\U0001F574";
+  }
+  input.push_back(0xff);
+  std::size_t chunks{};
+  for_each_chunk(std::u8string_view{input} | to_utf16,
+                 [&chunks](std::span<char16_t const>) { ++chunks; });
+  return 1 < chunks && chunks_match_elements_all(std::u8string_view{input});
+}
+
+// An lvalue view that owns its input cannot copy its base out, so its
+// elements are collected into blocks.
+constexpr bool for_each_chunk_owning_test() {
+  std::u8string input;
+  for (int i = 0; i != 100; ++i) {
+    input += u8"aé人\U0001F574";
+  }
+  input.push_back(0xff);
+  std::u16string const expected{input | to_utf16 | std::ranges::to<std::u16string>()};
+  auto view{std::u8string{input} | to_utf16};
+  std::u16string chunked;
+  std::size_t chunks{};
+  for_each_chunk(view, [&](std::span<char16_t const> chunk) {
+    ++chunks;
+    chunked.append(chunk.begin(), chunk.end());
+  });
+  auto errors{std::u8string{input} | to_utf16_or_error};
+  std::size_t elements{};
+  for_each_chunk(errors, [&](std::span<std::expected<char16_t, utf_transcoding_error> const> chunk) {
+    elements += chunk.size();
+  });
+  return 1 < chunks && chunked == expected && elements == expected.size();
+}
+
+CONSTEXPR_UNLESS_MSVC bool for_each_chunk_test() {
+  if (!for_each_chunk_valid_test()) {
+    return false;
+  }
+  if (!for_each_chunk_invalid_test()) {
+    return false;
+  }
+  if (!for_each_chunk_block_test()) {
+    return false;
+  }
+  if (!for_each_chunk_owning_test()) {
+    return false;
+  }
+  return true;
+}
+
+#ifndef _MSC_VER
+static_assert(for_each_chunk_test());
+#endif
+
+bool for_each_chunk_input_iterator_test() {
+  std::initializer_list<char8_t> arr{u8'b', 0xc3, 0xa9, u8'r', 0xc3};
+  test_input_iterator it(arr);
+  std::u16string out;
+  for_each_chunk(std::ranges::subrange{std::move(it), std::default_sentinel} | to_utf16,
+                 [&out](std::span<char16_t const> chunk) { out.append(chunk.begin(), chunk.end()); });
+  return out == u"bér�";
+}
+
+static auto const init{[] {
+  framework::tests().insert({"for_each_chunk_test", &for_each_chunk_test});
+  framework::tests().insert({"for_each_chunk_input_iterator_test", &for_each_chunk_input_iterator_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
+#include <beman/utf_view/from_bom_view.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <framework.hpp>
+#include <test_inputs.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+static_assert(std::ranges::bidirectional_range<from_bom_view<std::span<std::byte const>,
+                                                             to_utf_view_error_kind::replacement, char8_t>>);
+static_assert(std::ranges::common_range<from_bom_view<std::string_view, to_utf_view_error_kind::expected, char16_t>>);
+static_assert(std::ranges::borrowed_range<decltype(std::string_view{} | from_bom<char32_t>)>);
+
+// The bytes of a byte order mark and then units, each in the byte order
+// endian.
+template <class Byte, exposition_only_code_unit CharT>
+constexpr std::vector<Byte> bytes_of(std::basic_string_view<CharT> units, std::endian endian, bool bom) {
+  std::basic_string<CharT> all;
+  if (bom) {
+    all = U"\uFEFF"sv | to_utf<CharT> | std::ranges::to<std::basic_string<CharT>>();
+  }
+  all += units;
+  std::vector<Byte> result;
+  for (CharT const unit : all) {
+    for (std::size_t i = 0; i != sizeof(CharT); ++i) {
+      std::size_t const shift{endian == std::endian::little ? i : sizeof(CharT) - 1 - i};
+      result.push_back(static_cast<Byte>(static_cast<std::uint32_t>(unit) >> (8 * shift)));
+    }
+  }
+  return result;
+}
+
+// Both from the view and from the view that from_bom passes to a function.
+template <exposition_only_code_unit ToType, class Byte, exposition_only_code_unit FromType>
+constexpr bool from_bom_matches(std::vector<Byte> const& bytes, std::basic_string_view<FromType> units,
+                                bom_encoding encoding) {
+  auto const view{bytes | from_bom<ToType>};
+  auto const or_error_view{bytes | from_bom_or_error<ToType>};
+  return view.encoding() == encoding && std::ranges::equal(view, units | to_utf<ToType>) &&
+      std::ranges::equal(or_error_view, units | to_utf_or_error<ToType>) &&
+      std::ranges::equal(view | std::views::reverse, units | to_utf<ToType> | std::views::reverse) &&
+      std::ranges::equal(or_error_view | std::views::reverse, units | to_utf_or_error<ToType> | std::views::reverse) &&
+      from_bom<ToType>(bytes, [&](auto const& v) { return std::ranges::equal(v, units | to_utf<ToType>); }) &&
+      from_bom_or_error<ToType>(bytes,
+                                [&](auto const& v) { return std::ranges::equal(v, units | to_utf_or_error<ToType>); });
+}
+
+template <class Byte, exposition_only_code_unit FromType>
+constexpr bool from_bom_matches_all(std::vector<Byte> const& bytes, std::basic_string_view<FromType> units,
+                                    bom_encoding encoding) {
+  return from_bom_matches<char8_t>(bytes, units, encoding) && from_bom_matches<char16_t>(bytes, units, encoding) &&
+      from_bom_matches<char32_t>(bytes, units, encoding);
+}
+
+// Every encoding, with and without errors, and with bytes of type char,
+// unsigned char, std::byte, and char8_t.
+template <class Byte>
+constexpr bool from_bom_encodings_match() {
+  std::u16string_view const utf16_errors{invalid_utf16_input};
+  std::u32string_view const utf32_errors{invalid_utf32_input};
+  auto const utf8{u8"Qϕ学𡪇 text\xff\xc0 𡪇"sv};
+  auto const utf16{u"Qϕ学𡪇 text 𡪇"sv};
+  auto const utf32{U"Qϕ学𡪇 text 𡪇"sv};
+  return from_bom_matches_all(bytes_of<Byte>(utf8, std::endian::little, true), utf8, bom_encoding::utf8) &&
+      from_bom_matches_all(bytes_of<Byte>(utf8, std::endian::little, false), utf8, bom_encoding::utf8) &&
+      from_bom_matches_all(bytes_of<Byte>(utf16, std::endian::little, true), utf16, bom_encoding::utf16le) &&
+      from_bom_matches_all(bytes_of<Byte>(utf16, std::endian::big, true), utf16, bom_encoding::utf16be) &&
+      from_bom_matches_all(bytes_of<Byte>(utf16_errors, std::endian::little, true), utf16_errors,
+                           bom_encoding::utf16le) &&
+      from_bom_matches_all(bytes_of<Byte>(utf16_errors, std::endian::big, true), utf16_errors,
+                           bom_encoding::utf16be) &&
+      from_bom_matches_all(bytes_of<Byte>(utf32, std::endian::little, true), utf32, bom_encoding::utf32le) &&
+      from_bom_matches_all(bytes_of<Byte>(utf32, std::endian::big, true), utf32, bom_encoding::utf32be) &&
+      from_bom_matches_all(bytes_of<Byte>(utf32_errors, std::endian::little, true), utf32_errors,
+                           bom_encoding::utf32le) &&
+      from_bom_matches_all(bytes_of<Byte>(utf32_errors, std::endian::big, true), utf32_errors,
+                           bom_encoding::utf32be) &&
+      from_bom_matches_all(bytes_of<Byte>(u""sv, std::endian::big, true), u""sv, bom_encoding::utf16be);
+}
+
+CONSTEXPR_UNLESS_MSVC bool from_bom_test() {
+  return from_bom_encodings_match<char>() && from_bom_encodings_match<unsigned char>() &&
+      from_bom_encodings_match<std::byte>() && from_bom_encodings_match<char8_t>();
+}
+
+#ifndef _MSC_VER
+static_assert(from_bom_test());
+#endif
+
+// A partial code unit at the end decodes to one more replacement character,
+// after whatever the code units before it decode to.
+CONSTEXPR_UNLESS_MSVC bool from_bom_partial_code_unit_test() {
+  std::vector<unsigned char> utf16le{bytes_of<unsigned char>(u"AB\xD800"sv, std::endian::little, true)};
+  utf16le.push_back(0x41);
+  std::vector<unsigned char> utf32be{bytes_of<unsigned char>(U"A"sv, std::endian::big, true)};
+  utf32be.push_back(0x00);
+  utf32be.push_back(0x00);
+  utf32be.push_back(0x42);
+  std::vector<unsigned char> const odd_utf16be{0xFE, 0xFF, 0x00};
+  constexpr char32_t utf32be_units[]{U'A', 0xFFFFFFFF};
+  return from_bom_matches_all(utf16le, u"AB\xD800\xD800"sv, bom_encoding::utf16le) &&
+      from_bom_matches_all(utf32be, std::u32string_view{std::begin(utf32be_units), std::end(utf32be_units)},
+                           bom_encoding::utf32be) &&
+      std::ranges::equal(utf32be | from_bom<char8_t>, u8"A�"sv) &&
+      *std::ranges::next((utf32be | from_bom_or_error<char32_t>).begin()) ==
+      std::unexpected{utf_transcoding_error::out_of_range} &&
+      std::ranges::equal(odd_utf16be | from_bom<char16_t>, u"�"sv) &&
+      *(utf16le | from_bom_or_error<char8_t> | std::views::reverse).begin() ==
+      std::unexpected{utf_transcoding_error::unpaired_high_surrogate};
+}
+
+#ifndef _MSC_VER
+static_assert(from_bom_partial_code_unit_test());
+#endif
+
+CONSTEXPR_UNLESS_MSVC bool detect_bom_test() {
+  return detect_bom(""sv) == detected_bom{.encoding = bom_encoding::utf8, .size = 0} &&
+      detect_bom("\xEF\xBB"sv) == detected_bom{.encoding = bom_encoding::utf8, .size = 0} &&
+      detect_bom("\xEF\xBB\xBF"sv) == detected_bom{.encoding = bom_encoding::utf8, .size = 3} &&
+      detect_bom("\xFF\xFE"sv) == detected_bom{.encoding = bom_encoding::utf16le, .size = 2} &&
+      detect_bom("\xFF\xFE\x00"sv) == detected_bom{.encoding = bom_encoding::utf16le, .size = 2} &&
+      detect_bom("\xFF\xFE\x00\x00"sv) == detected_bom{.encoding = bom_encoding::utf32le, .size = 4} &&
+      detect_bom("\xFE\xFF\x00\x00"sv) == detected_bom{.encoding = bom_encoding::utf16be, .size = 2} &&
+      detect_bom("\x00\x00\xFE\xFF"sv) == detected_bom{.encoding = bom_encoding::utf32be, .size = 4} &&
+      detect_bom("\x00\x00\xFF\xFE"sv) == detected_bom{.encoding = bom_encoding::utf8, .size = 0} &&
+      ("\xFF\xFE"sv | from_bom<char8_t>).empty() && ("\xFF\xFE"sv | from_bom<char8_t>).bom_size() == 2;
+}
+
+#ifndef _MSC_VER
+static_assert(detect_bom_test());
+#endif
+
+static auto const init{[] {
+  framework::tests().insert({"from_bom_test", &from_bom_test});
+  framework::tests().insert({"from_bom_partial_code_unit_test", &from_bom_partial_code_unit_test});
+  framework::tests().insert({"detect_bom_test", &detect_bom_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/indexed_utf_view.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <framework.hpp>
+#include <test_inputs.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+static_assert(std::ranges::random_access_range<indexed_utf_view<std::u8string_view>>);
+static_assert(std::ranges::sized_range<indexed_utf_view<std::u16string_view>>);
+static_assert(std::ranges::random_access_range<indexed_utf_view<std::u16string_view> const>);
+
+// Checks every way of reaching every position of input | indexed_utf
+// against input | to_utf32.
+template <exposition_only_code_unit FromType>
+bool indexed_matches_to_utf32(std::basic_string_view<FromType> input) {
+  std::u32string const expected{input | to_utf32 | std::ranges::to<std::u32string>()};
+  auto view{input | indexed_utf};
+  if (!std::ranges::equal(view, expected) ||
+      !std::ranges::equal(view | std::views::reverse, expected | std::views::reverse)) {
+    return false;
+  }
+  if (view.size() != expected.size() || std::ranges::end(view) - std::ranges::begin(view) !=
+                                            static_cast<std::ptrdiff_t>(expected.size())) {
+    return false;
+  }
+
+  std::vector<std::size_t> offsets;
+  for (auto it = view.begin(); it != view.end(); ++it) {
+    offsets.push_back(it.code_unit_offset());
+  }
+  auto const first{view.begin()};
+  auto const last{std::ranges::next(first, view.end())};
+  for (std::size_t n = 0; n != expected.size(); ++n) {
+    auto const d{static_cast<std::ptrdiff_t>(n)};
+    auto const it{std::ranges::next(first, d)};
+    if (view[d] != expected[n] || *it != expected[n] || it.code_unit_offset() != offsets[n] || it - first != d ||
+        *(last - (static_cast<std::ptrdiff_t>(expected.size()) - d)) != expected[n] ||
+        *(std::ranges::prev(it, std::min<std::ptrdiff_t>(d, 300)) + std::min<std::ptrdiff_t>(d, 300)) !=
+            expected[n]) {
+      return false;
+    }
+  }
+  return last == view.end() && last.code_unit_offset() == input.size();
+}
+
+bool indexed_utf_view_test() {
+  std::u8string const utf8{repeated(u8"Qϕ学𡪇 plain ASCII text "sv, 1000)};
+  std::u16string const utf16{repeated(u"Qϕ学𡪇 plain ASCII text "sv, 1000)};
+  std::u8string const invalid8{repeated(invalid_utf8_input, 1000)};
+  std::u16string const invalid16{repeated(invalid_utf16_input, 1000)};
+  return indexed_matches_to_utf32<char8_t>(utf8) && indexed_matches_to_utf32<char16_t>(utf16) &&
+      indexed_matches_to_utf32<char8_t>(invalid8) && indexed_matches_to_utf32<char16_t>(invalid16) &&
+      indexed_matches_to_utf32(u8"x"sv) && indexed_matches_to_utf32(std::u8string_view{}) &&
+      std::ranges::empty(std::u16string_view{} | indexed_utf);
+}
+
+// Iterators into a view stay valid when it is moved, and the moved-from
+// view can still be used.
+bool indexed_utf_view_move_test() {
+  std::u16string const input{repeated(u"Qϕ学𡪇 plain ASCII text "sv, 1000)};
+  std::u32string const expected{input | to_utf32 | std::ranges::to<std::u32string>()};
+  auto const n{static_cast<std::ptrdiff_t>(expected.size())};
+  auto view{std::u16string_view{input} | indexed_utf};
+  auto const first{view.begin()};
+  auto moved{std::move(view)};
+  auto assigned{std::u16string_view{} | indexed_utf};
+  assigned = std::move(moved);
+  return first[n - 1] == expected.back() && std::default_sentinel - first == n && assigned.size() == expected.size() &&
+      view.size() == expected.size() && view.begin()[n - 1] == expected.back() &&
+      std::ranges::end(view) - std::ranges::begin(view) == n && moved.size() == expected.size() &&
+      std::ranges::equal(moved, expected);
+}
+
+bool indexed_utf_view_threads_test() {
+  std::u8string const input{repeated(u8"aé人\U0001F574 "sv, 100000)};
+  std::u32string const expected{input | to_utf32 | std::ranges::to<std::u32string>()};
+  auto const view{input | indexed_utf};
+  std::vector<char> ok(8);
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t t = 0; t != ok.size(); ++t) {
+      // Each thread works on its own copy, all of which share the index.
+      threads.emplace_back([view, t, &ok, &expected] {
+        bool result{true};
+        for (std::size_t n = t; n < expected.size(); n += 997) {
+          result = result && view[static_cast<std::ptrdiff_t>(n)] == expected[n];
+        }
+        ok[t] = result && view.size() == expected.size();
+      });
+    }
+  }
+  return std::ranges::all_of(ok, [](char b) { return b != 0; });
+}
+
+static auto const init{[] {
+  framework::tests().insert({"indexed_utf_view_test", &indexed_utf_view_test});
+  framework::tests().insert({"indexed_utf_view_move_test", &indexed_utf_view_move_test});
+  framework::tests().insert({"indexed_utf_view_threads_test", &indexed_utf_view_threads_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/parallel_transcode.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcode.hpp>
+#include <framework.hpp>
+#include <test_inputs.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <cstddef>
+#include <execution>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+// Transcodes input with every chunk size up to one past the longest
+// subsequence, so that it is split at every position inside every multi-unit
+// sequence in it, and checks that the result is that of the sequential
+// overloads.
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+bool parallel_transcode_matches(std::basic_string_view<FromType> input) {
+  std::basic_string<ToType> expected(input.size() * 4, ToType{});
+  auto const expected_result{transcode<ToType>(input, expected.data())};
+  std::basic_string<ToType> expected_or_error(input.size() * 4, ToType{});
+  auto const expected_or_error_result{transcode_or_error<ToType>(input, expected_or_error.data())};
+
+  for (std::size_t chunk_size = 1; chunk_size != 6; ++chunk_size) {
+    std::basic_string<ToType> out(input.size() * 4, ToType{});
+    auto const result{detail::parallel_transcode_impl<to_utf_view_error_kind::replacement, ToType>(
+        std::execution::par, input, out.data(), chunk_size)};
+    if (result.in != expected_result.in || result.out - out.data() != expected_result.out - expected.data() ||
+        result.error != expected_result.error || out != expected) {
+      return false;
+    }
+
+    std::basic_string<ToType> out_or_error(input.size() * 4, ToType{});
+    auto const or_error_result{detail::parallel_transcode_impl<to_utf_view_error_kind::expected, ToType>(
+        std::execution::par, input, out_or_error.data(), chunk_size)};
+    if (or_error_result.in != expected_or_error_result.in ||
+        or_error_result.out - out_or_error.data() != expected_or_error_result.out - expected_or_error.data() ||
+        or_error_result.error != expected_or_error_result.error || out_or_error != expected_or_error) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <exposition_only_code_unit FromType>
+bool parallel_transcode_matches_all(std::basic_string_view<FromType> input) {
+  return holds_for_each_to_type(
+      [input]<class ToType>(std::type_identity<ToType>) { return parallel_transcode_matches<ToType>(input); });
+}
+
+bool parallel_transcode_chunk_boundary_test() {
+  auto const matches_all{[](auto input) { return parallel_transcode_matches_all(input); }};
+  return holds_for_valid_inputs(matches_all) && holds_for_invalid_inputs(matches_all);
+}
+
+bool parallel_transcode_test() {
+  std::u16string input;
+  while (input.size() <= 3 * detail::parallel_transcode_chunk_size) {
+    input += u"aé人\U0001F574 ";
+  }
+  input[2 * detail::parallel_transcode_chunk_size + 7] = 0xDC00;
+  input[detail::parallel_transcode_chunk_size + 3] = 0xD800;
+
+  std::u8string expected(input.size() * 3, u8'\0');
+  auto const expected_result{transcode(input, expected.data())};
+  std::u8string out(input.size() * 3, u8'\0');
+  auto const result{transcode(std::execution::par, input, out.data())};
+  if (result.in != input.end() || result.out - out.data() != expected_result.out - expected.data() ||
+      result.error != utf_transcoding_error::unpaired_high_surrogate || out != expected) {
+    return false;
+  }
+
+  std::size_t const error_offset{detail::parallel_transcode_chunk_size + 3};
+  std::u32string out_or_error(input.size(), U'\0');
+  auto const or_error_result{transcode_or_error(std::execution::par, input | to_utf8, out_or_error.data())};
+  return or_error_result.in == input.begin() + static_cast<std::ptrdiff_t>(error_offset) &&
+      or_error_result.error == utf_transcoding_error::unpaired_high_surrogate &&
+      std::u32string_view{out_or_error.data(), or_error_result.out} ==
+      (std::u16string_view{input}.substr(0, error_offset) | to_utf32 | std::ranges::to<std::u32string>());
+}
+
+static auto const init{[] {
+  framework::tests().insert({"parallel_transcode_chunk_boundary_test", &parallel_transcode_chunk_boundary_test});
+  framework::tests().insert({"parallel_transcode_test", &parallel_transcode_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
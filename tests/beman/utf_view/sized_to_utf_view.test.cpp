@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/code_unit_view.hpp>
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
+#include <beman/utf_view/sized_to_utf_view.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <framework.hpp>
+#include <test_inputs.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+static_assert(std::ranges::sized_range<decltype(u8""sv | to_utf16 | sized_utf)>);
+static_assert(std::ranges::borrowed_range<decltype(u8""sv | to_utf16 | sized_utf)>);
+static_assert(std::ranges::bidirectional_range<decltype(u8""sv | to_utf16 | sized_utf)>);
+static_assert(std::ranges::sized_range<decltype(std::views::take(u8""sv | to_utf32 | sized_utf, 1))>);
+static_assert(std::same_as<decltype(U""sv | to_utf32 | sized_utf), decltype(U""sv | to_utf32)>);
+
+// The size of view | sized_utf is the number of elements of view, before and
+// after it is cached, and the views and containers built from it are the
+// same as those built from view.
+template <class View>
+constexpr bool sized_matches(View view) {
+  using value_type = std::ranges::range_value_t<View>;
+  std::vector<value_type> const expected{view | std::ranges::to<std::vector<value_type>>()};
+  auto sized{view | sized_utf};
+  auto const& const_sized{sized};
+  if (sized.empty() != expected.empty() || const_sized.size() != expected.size() ||
+      sized.size() != expected.size()) {
+    return false;
+  }
+  auto const copy{sized};
+  if (copy.size() != expected.size() || (sized | std::ranges::to<std::vector<value_type>>()) != expected) {
+    return false;
+  }
+  std::ptrdiff_t const half{static_cast<std::ptrdiff_t>(expected.size() / 2)};
+  auto taken{sized | std::views::take(half)};
+  auto dropped{sized | std::views::drop(half)};
+  return taken.size() == static_cast<std::size_t>(half) && dropped.size() == expected.size() - taken.size() &&
+      std::ranges::equal(dropped, expected | std::views::drop(half));
+}
+
+template <exposition_only_code_unit ToType, class R>
+constexpr bool sized_matches_views(R input, bool well_formed) {
+  return sized_matches(input | to_utf<ToType>) && sized_matches(input | to_utf_or_error<ToType>) &&
+      (!well_formed || sized_matches(input | to_utf_assume_valid<ToType>));
+}
+
+template <class R>
+constexpr bool sized_matches_all(R input, bool well_formed) {
+  return holds_for_each_to_type([&]<class ToType>(std::type_identity<ToType>) {
+    return sized_matches_views<ToType>(input, well_formed);
+  });
+}
+
+constexpr bool sized_to_utf_view_valid_test() {
+  std::u8string const utf8{repeated(u8"aé人\U0001F574 ascii text "sv, 1000)};
+  std::u16string const utf16{utf8 | to_utf16 | std::ranges::to<std::u16string>()};
+  std::u32string const utf32{utf8 | to_utf32 | std::ranges::to<std::u32string>()};
+  return sized_matches_all(std::u8string_view{utf8}, true) && sized_matches_all(std::u16string_view{utf16}, true) &&
+      sized_matches_all(std::u32string_view{utf32}, true) && sized_matches_all(u8""sv, true);
+}
+
+constexpr bool sized_to_utf_view_invalid_test() {
+  return holds_for_invalid_inputs([](auto input) { return sized_matches_all(input, false); });
+}
+
+// Input that is not contiguous is counted by decoding it.
+constexpr bool sized_to_utf_view_forward_test() {
+  constexpr char8_t utf8[]{u8'b', 0xc3, 0xa9, 0xff, u8'r'};
+  auto const all{[](char8_t) { return true; }};
+  std::vector<char> const chars{'a', static_cast<char>(0xc3), static_cast<char>(0xa9)};
+  return sized_matches_all(std::u8string_view{std::begin(utf8), std::end(utf8)} | std::views::filter(all), false) &&
+      sized_matches_all(chars | as_char8_t, true);
+}
+
+CONSTEXPR_UNLESS_MSVC bool sized_to_utf_view_test() {
+  if (!sized_to_utf_view_valid_test()) {
+    return false;
+  }
+  if (!sized_to_utf_view_invalid_test()) {
+    return false;
+  }
+  if (!sized_to_utf_view_forward_test()) {
+    return false;
+  }
+  return true;
+}
+
+#ifndef _MSC_VER
+static_assert(sized_to_utf_view_test());
+#endif
+
+static auto const init{[] {
+  framework::tests().insert({"sized_to_utf_view_test", &sized_to_utf_view_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BEMAN_UTF_VIEW_TESTS_TEST_INPUTS_HPP
+#define BEMAN_UTF_VIEW_TESTS_TEST_INPUTS_HPP
+
+#include <beman/utf_view/config.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#endif
+
+namespace beman::utf_view::tests {
+
+// The same well-formed text in each encoding, with code points of every
+// length.
+inline constexpr std::u8string_view valid_utf8_input{u8"Qϕ学𡪇 plain ASCII text"};
+inline constexpr std::u16string_view valid_utf16_input{u"Qϕ学𡪇 plain ASCII text"};
+inline constexpr std::u32string_view valid_utf32_input{U"Qϕ学𡪇 plain ASCII text"};
+
+inline constexpr char8_t invalid_utf8_units[]{0xc0, 0xaf, 0xe0, 0x80, 0xbf, 0xf0, 0x81, 0x82, 'A',
+                                              0xed, 0xa0, 0x80, 0xf4, 0x91, 0x92, 0x93, 0xff, 'B',
+                                              0xe1, 0x80, 0xe2, 0xf0, 0x91, 0x92, 0xf1, 0xbf, 'C',
+                                              0x80, 0x80, 0x80, 0x80, 0x80, 0xf0, 0x90, 0x80};
+inline constexpr char16_t invalid_utf16_units[]{0xD800, u'A', 0xDC00, 0xD800, 0xDC00, 0xDC00, 0xD800, 0xD800};
+inline constexpr char32_t invalid_utf32_units[]{0xDC00, U'A', 0x110000, 0x10FFFF};
+
+// Ill-formed input in each encoding: overlong, surrogate, out of range and
+// truncated UTF-8 sequences, a run of stray continuation bytes, and a
+// sequence cut off by the end of the input; unpaired UTF-16 surrogates of
+// both kinds, including at the end; and UTF-32 surrogates and values past
+// U+10FFFF.
+inline constexpr std::u8string_view invalid_utf8_input{std::begin(invalid_utf8_units), std::end(invalid_utf8_units)};
+inline constexpr std::u16string_view invalid_utf16_input{std::begin(invalid_utf16_units),
+                                                         std::end(invalid_utf16_units)};
+inline constexpr std::u32string_view invalid_utf32_input{std::begin(invalid_utf32_units),
+                                                         std::end(invalid_utf32_units)};
+
+// Whether check(std::type_identity<ToType>{}) holds for each code unit type
+// ToType.
+template <class Check>
+constexpr bool holds_for_each_to_type(Check const& check) {
+  return check(std::type_identity<char8_t>{}) && check(std::type_identity<char16_t>{}) &&
+      check(std::type_identity<char32_t>{});
+}
+
+// Whether check(input) holds for the well-formed text in each encoding and
+// for an empty input.
+template <class Check>
+constexpr bool holds_for_valid_inputs(Check const& check) {
+  return check(valid_utf8_input) && check(valid_utf16_input) && check(valid_utf32_input) &&
+      check(std::u8string_view{});
+}
+
+// Whether check(input) holds for the ill-formed input in each encoding.
+template <class Check>
+constexpr bool holds_for_invalid_inputs(Check const& check) {
+  return check(invalid_utf8_input) && check(invalid_utf16_input) && check(invalid_utf32_input);
+}
+
+// pattern repeated until it is at least code_units long.
+template <class CharT>
+constexpr std::basic_string<CharT> repeated(std::basic_string_view<CharT> pattern, std::size_t code_units) {
+  std::basic_string<CharT> result;
+  while (result.size() < code_units) {
+    result += pattern;
+  }
+  return result;
+}
+
+} // namespace beman::utf_view::tests
+
+#endif // BEMAN_UTF_VIEW_TESTS_TEST_INPUTS_HPP
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
+#include <beman/utf_view/to_utf_readahead.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <framework.hpp>
+#include <test_inputs.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+static_assert(std::ranges::forward_range<decltype(u8""sv | to_utf16_readahead)>);
+static_assert(std::ranges::borrowed_range<decltype(u8""sv | to_utf16_readahead)>);
+static_assert(std::ranges::forward_range<decltype(std::u8string{} | to_utf32_readahead) const>);
+
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr bool readahead_matches_to_utf(std::basic_string_view<FromType> input) {
+  std::vector<ToType> const expected{input | to_utf<ToType> | std::ranges::to<std::vector<ToType>>()};
+  auto view{input | to_utf_readahead<ToType>};
+  if ((view | std::ranges::to<std::vector<ToType>>()) != expected) {
+    return false;
+  }
+  // Copies of an iterator must continue independently of the original, and
+  // iterators reaching the same element by different copies compare equal.
+  auto it = view.begin();
+  auto const first = it;
+  for (std::size_t i = 0; i != expected.size(); ++i, ++it) {
+    if (*it != expected[i] || it == std::default_sentinel) {
+      return false;
+    }
+  }
+  auto other = first;
+  std::ranges::advance(other, static_cast<std::ptrdiff_t>(expected.size()));
+  return it == std::default_sentinel && other == it && (expected.empty() || first != it);
+}
+
+template <exposition_only_code_unit FromType>
+constexpr bool readahead_matches_to_utf_all(std::basic_string_view<FromType> input) {
+  return holds_for_each_to_type(
+      [input]<class ToType>(std::type_identity<ToType>) { return readahead_matches_to_utf<ToType>(input); });
+}
+
+constexpr bool to_utf_readahead_valid_test() {
+  return holds_for_valid_inputs([](auto input) { return readahead_matches_to_utf_all(input); });
+}
+
+constexpr bool to_utf_readahead_invalid_test() {
+  return holds_for_invalid_inputs([](auto input) { return readahead_matches_to_utf_all(input); });
+}
+
+// Inputs spanning several buffer refills, with multi-unit code points
+// straddling each possible buffer boundary.
+constexpr bool to_utf_readahead_refill_test() {
+  std::u8string input;
+  for (int i = 0; i != 40; ++i) {
+    input += u8"aé人\U0001F574 ascii";
+    input.push_back(static_cast<char8_t>(i % 3 ? 'x' : 0xff));
+  }
+  std::u16string const utf16{std::u8string_view{input} | to_utf16 | std::ranges::to<std::u16string>()};
+  std::u32string const utf32{std::u8string_view{input} | to_utf32 | std::ranges::to<std::u32string>()};
+  return readahead_matches_to_utf_all(std::u8string_view{input}) &&
+      readahead_matches_to_utf_all(std::u16string_view{utf16}) &&
+      readahead_matches_to_utf_all(std::u32string_view{utf32});
+}
+
+CONSTEXPR_UNLESS_MSVC bool to_utf_readahead_test() {
+  if (!to_utf_readahead_valid_test()) {
+    return false;
+  }
+  if (!to_utf_readahead_invalid_test()) {
+    return false;
+  }
+  if (!to_utf_readahead_refill_test()) {
+    return false;
+  }
+  return true;
+}
+
+#ifndef _MSC_VER
+static_assert(to_utf_readahead_test());
+#endif
+
+static auto const init{[] {
+  framework::tests().insert({"to_utf_readahead_test", &to_utf_readahead_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
@@ -6,26 +6,34 @@
 //          https://www.boost.org/LICENSE_1_0.txt)
 
 #include <beman/utf_view/config.hpp>
+#include <beman/utf_view/code_unit_view.hpp>
 #include <beman/utf_view/detail/constant_wrapper_polyfill.hpp>
 #include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
+#include <beman/utf_view/endian_view.hpp>
 #include <beman/utf_view/null_term.hpp>
 #include <beman/utf_view/to_utf_view.hpp>
 #include <framework.hpp>
+#include <test_inputs.hpp>
 #include <test_iterators.hpp>
 #if BEMAN_UTF_VIEW_USE_MODULES()
 import std;
 #else
 #include <algorithm>
+#include <bit>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <initializer_list>
 #include <ios>
 #include <iterator>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 #endif
 
 namespace beman::utf_view::tests {
@@ -1457,6 +1465,423 @@ constexpr bool input_range_equality_test() {
   return true;
 }
 
+// Long ASCII runs in contiguous UTF-8 are read a block at a time; the result
+// must be the same as decoding them one at a time from a non-contiguous view.
+template <exposition_only_code_unit ToType>
+constexpr bool ascii_run_test_impl(std::u8string_view input) {
+  auto view{input | to_utf<ToType>};
+  auto reference{input | std::views::filter([](char8_t) { return true; }) | to_utf<ToType>};
+  if (!std::ranges::equal(view, reference)) {
+    return false;
+  }
+  std::basic_string<ToType> backward;
+  for (auto it = view.end(); it != view.begin();) {
+    backward.push_back(*--it);
+  }
+  std::ranges::reverse(backward);
+  if (!std::ranges::equal(backward, reference)) {
+    return false;
+  }
+  auto it{view.begin()};
+  auto ref_it{reference.begin()};
+  for (int i = 0; it != view.end(); ++i) {
+    if (*it != *ref_it) {
+      return false;
+    }
+    if (i % 7 == 3 && it != view.begin()) {
+      --it;
+      --ref_it;
+      if (*it != *ref_it) {
+        return false;
+      }
+      ++it;
+      ++ref_it;
+    }
+    ++it;
+    ++ref_it;
+  }
+  return ref_it == reference.end();
+}
+
+constexpr bool ascii_run_test() {
+  std::u8string input;
+  for (int i = 0; i != 150; ++i) {
+    input.push_back(static_cast<char8_t>(u8'a' + i % 26));
+  }
+  input += u8"é";
+  input += std::u8string(70, u8'x');
+  input.push_back(0xff);
+  input += u8"tail\U0001F574";
+  for (std::size_t n : {std::size_t{0}, std::size_t{1}, std::size_t{63}, std::size_t{64},
+                        std::size_t{65}, std::size_t{151}, input.size()}) {
+    std::u8string_view const prefix{std::u8string_view{input}.substr(0, n)};
+    if (!ascii_run_test_impl<char8_t>(prefix) || !ascii_run_test_impl<char16_t>(prefix) ||
+        !ascii_run_test_impl<char32_t>(prefix)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Decode input one code point at a time with both UTF-8 decoders, and check
+// that they produce the same code points, errors and positions.
+constexpr bool utf8_decoders_agree(std::u8string_view input) {
+  auto cascade_it{input.begin()};
+  auto dfa_it{input.begin()};
+  while (cascade_it != input.end()) {
+    detail::decode_code_point_result const cascade{
+        detail::decode_code_point_utf8_cascade_impl(cascade_it, input.end())};
+    detail::decode_code_point_result const dfa{detail::decode_code_point_utf8_dfa_impl(dfa_it, input.end())};
+    if (cascade.c != dfa.c || cascade.to_incr != dfa.to_incr || cascade.success != dfa.success ||
+        cascade_it != dfa_it) {
+      return false;
+    }
+  }
+  return dfa_it == input.end();
+}
+
+constexpr bool utf8_dfa_decoder_test() {
+  return utf8_decoders_agree(u8"Qϕ学𡪇 ascii \U0010FFFF\uD7FF\uE000"sv) &&
+      utf8_decoders_agree(invalid_utf8_input);
+}
+
+// Every lead byte, followed by every truncation of each combination of
+// trailing bytes drawn from the boundaries of the byte classes.
+bool utf8_dfa_decoder_exhaustive_test() {
+  constexpr char8_t trailing[]{0x00, 0x41, 0x7f, 0x80, 0x8f, 0x90, 0x9f, 0xa0,
+                               0xbf, 0xc0, 0xc2, 0xe0, 0xed, 0xf0, 0xf4, 0xff};
+  for (int lead = 0; lead != 256; ++lead) {
+    for (char8_t const b1 : trailing) {
+      for (char8_t const b2 : trailing) {
+        for (char8_t const b3 : trailing) {
+          char8_t const input[]{static_cast<char8_t>(lead), b1, b2, b3};
+          for (std::size_t length = 1; length <= 4; ++length) {
+            if (!utf8_decoders_agree(std::u8string_view{input, length})) {
+              return false;
+            }
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Check that the packed encoder, and the view whose iterator stores its
+// result, produce the same code units as encode_code_point for c.
+template <exposition_only_code_unit ToType>
+constexpr bool packed_encoder_agrees(char32_t c) {
+  ToType expected[detail::max_code_units<ToType>]{};
+  ToType const* const expected_end{detail::encode_code_point<ToType>(c, +expected)};
+  std::basic_string_view<ToType> const expected_view{+expected, expected_end};
+  detail::packed_code_units const packed{detail::encode_code_point_packed<ToType>(c)};
+  if (packed.length != expected_view.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i != expected_view.size(); ++i) {
+    if (static_cast<ToType>(packed.units >> (i * 8 * sizeof(ToType))) != expected_view[i]) {
+      return false;
+    }
+  }
+  return std::ranges::equal(std::u32string_view{&c, 1} | to_utf<ToType>, expected_view);
+}
+
+constexpr bool packed_encoder_agrees_all(char32_t c) {
+  return packed_encoder_agrees<char8_t>(c) && packed_encoder_agrees<char16_t>(c) &&
+      packed_encoder_agrees<char32_t>(c);
+}
+
+constexpr bool packed_encoder_test() {
+  for (char32_t const c : U"\0\x7F\x80\x7FF\x800\uD7FF\uE000\uFFFF\U00010000\U0010FFFFQϕ学𡪇"sv) {
+    if (!packed_encoder_agrees_all(c)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool packed_encoder_exhaustive_test() {
+  for (char32_t c = 0; c <= 0x10FFFF; ++c) {
+    if ((c < 0xD800 || 0xDFFF < c) && !packed_encoder_agrees_all(c)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <exposition_only_code_unit ToType, class R>
+constexpr bool assume_valid_matches(R r) {
+  if (!std::ranges::equal(r | to_utf_assume_valid<ToType>, r | to_utf<ToType>)) {
+    return false;
+  }
+  if constexpr (std::ranges::bidirectional_range<R>) {
+    if (!std::ranges::equal(r | to_utf_assume_valid<ToType> | std::views::reverse,
+                            r | to_utf<ToType> | std::views::reverse)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <exposition_only_code_unit FromType>
+constexpr bool assume_valid_matches_all(std::basic_string_view<FromType> input) {
+  auto forward_input{input | std::views::filter([](FromType) { return true; })};
+  return assume_valid_matches<char8_t>(input) && assume_valid_matches<char16_t>(input) &&
+      assume_valid_matches<char32_t>(input) && assume_valid_matches<char8_t>(forward_input) &&
+      assume_valid_matches<char16_t>(forward_input) && assume_valid_matches<char32_t>(forward_input);
+}
+
+constexpr bool assume_valid_test() {
+  static_assert(std::same_as<std::ranges::range_value_t<decltype(u8"x"sv | to_utf16_assume_valid)>, char16_t>);
+  static_assert(std::same_as<decltype(std::views::empty<char8_t> | to_utf32_assume_valid),
+                             std::ranges::empty_view<char32_t>>);
+  return assume_valid_matches_all(u8"Qϕ学𡪇 \U0010FFFF\uD7FF\uE000\u0080\u07FF\u0800\U00010000 plain ASCII text"sv) &&
+      assume_valid_matches_all(u"Qϕ学𡪇 \U0010FFFF\uD7FF\uE000\u0080\u07FF\u0800\U00010000 plain ASCII text"sv) &&
+      assume_valid_matches_all(U"Qϕ学𡪇 \U0010FFFF\uD7FF\uE000\u0080\u07FF\u0800\U00010000 plain ASCII text"sv) &&
+      assume_valid_matches_all(std::u8string_view{});
+}
+
+// to_utfN_assume_valid over a view that replaces or reports errors checks
+// the input of that view, which can be ill-formed, rather than assuming it
+// is valid.
+constexpr bool assume_valid_nested_test() {
+  constexpr char8_t invalid_utf8[]{'a', 0xe0, 0x80, 0xbf, 0xf0, 0x9f, 0x98, 'b', 0xff, 0xc3, 0xa9};
+  std::u8string_view const input{std::begin(invalid_utf8), std::end(invalid_utf8)};
+  auto utf32{input | to_utf32};
+  auto or_error{input | to_utf16_or_error};
+  static_assert(std::same_as<decltype(utf32 | to_utf8_assume_valid), decltype(input | to_utf8)>);
+  static_assert(std::same_as<decltype(or_error | to_utf8_assume_valid), decltype(input | to_utf8)>);
+  static_assert(std::same_as<decltype(std::ranges::subrange(utf32.begin(), utf32.end()) | to_utf8_assume_valid),
+                             to_utf_view<std::ranges::subrange<std::u8string_view::const_iterator>,
+                                         to_utf_view_error_kind::replacement, char8_t>>);
+  static_assert(std::same_as<decltype(input | to_utf32_assume_valid | to_utf8_assume_valid),
+                             decltype(input | to_utf8_assume_valid)>);
+  return std::ranges::equal(utf32 | to_utf8_assume_valid, utf32 | to_utf8) &&
+      std::ranges::equal(utf32 | to_utf8_assume_valid, input | to_utf8) &&
+      std::ranges::equal(or_error | to_utf8_assume_valid, input | to_utf8) &&
+      std::ranges::equal(std::ranges::subrange(utf32.begin(), utf32.end()) | to_utf8_assume_valid, input | to_utf8) &&
+      std::ranges::equal(utf32 | to_utf8_assume_valid | std::views::reverse, input | to_utf8 | std::views::reverse);
+}
+
+template <class CharT>
+constexpr detail::as_code_unit_impl<CharT> as_code_unit{};
+
+template <class R>
+constexpr auto from_foreign_endian(R&& r) {
+  if constexpr (std::endian::native == std::endian::little) {
+    return std::forward<R>(r) | from_big_endian;
+  } else {
+    return std::forward<R>(r) | from_little_endian;
+  }
+}
+
+template <exposition_only_code_unit ToType, class Int, class CharT>
+constexpr bool byteswap_fusion_matches(std::basic_string_view<CharT> input) {
+  std::vector<Int> swapped;
+  for (CharT const c : input) {
+    swapped.push_back(std::byteswap(static_cast<Int>(c)));
+  }
+  std::span<Int const> const units{swapped};
+  if constexpr (std::endian::native == std::endian::big || std::endian::native == std::endian::little) {
+    using fused_base = decltype((from_foreign_endian(units) | as_code_unit<CharT> | to_utf<ToType>).base());
+    static_assert(std::same_as<fused_base,
+                               beman::transform_view::transform_view<std::span<Int const>, detail::byteswap_to<CharT>>>);
+  }
+  return std::ranges::equal(from_foreign_endian(units) | as_code_unit<CharT> | to_utf<ToType>, input | to_utf<ToType>) &&
+      std::ranges::equal(from_foreign_endian(units) | as_code_unit<CharT> | to_utf_or_error<ToType>,
+                         input | to_utf_or_error<ToType>) &&
+      std::ranges::equal(from_foreign_endian(units) | as_code_unit<CharT> | to_utf<ToType> | std::views::reverse,
+                         input | to_utf<ToType> | std::views::reverse);
+}
+
+template <class Int, class CharT>
+constexpr bool byteswap_fusion_matches_all(std::basic_string_view<CharT> input) {
+  return byteswap_fusion_matches<char8_t, Int>(input) && byteswap_fusion_matches<char16_t, Int>(input) &&
+      byteswap_fusion_matches<char32_t, Int>(input);
+}
+
+// from_big_endian(r) | as_char16_t | to_utf8 and the like swap and cast in
+// one transform_view, with the same result as the two views they replace.
+constexpr bool byteswap_fusion_test() {
+  return byteswap_fusion_matches_all<std::uint16_t>(valid_utf16_input) &&
+      byteswap_fusion_matches_all<std::uint16_t>(invalid_utf16_input) &&
+      byteswap_fusion_matches_all<std::uint32_t>(valid_utf32_input) &&
+      byteswap_fusion_matches_all<std::uint32_t>(invalid_utf32_input);
+}
+
+// as_char8_t over contiguous chars finds ASCII runs a block at a time, as
+// contiguous char8_t does, with the same result as decoding each code point.
+template <exposition_only_code_unit ToType>
+constexpr bool char_ascii_runs_match(std::u8string_view input) {
+  std::string const chars(input.begin(), input.end());
+  return std::ranges::equal(chars | as_char8_t | to_utf<ToType>, input | to_utf<ToType>) &&
+      std::ranges::equal(chars | as_char8_t | to_utf_or_error<ToType>, input | to_utf_or_error<ToType>) &&
+      std::ranges::equal(chars | as_char8_t | to_utf<ToType> | std::views::reverse,
+                         input | to_utf<ToType> | std::views::reverse);
+}
+
+constexpr bool char_ascii_runs_test() {
+  std::u8string input;
+  for (int i = 0; i != 20; ++i) {
+    input += u8"a run of ASCII long enough to fill more than one 64 byte block, then ϕ学𡪇\xff ";
+  }
+  return char_ascii_runs_match<char8_t>(input) && char_ascii_runs_match<char16_t>(input) &&
+      char_ascii_runs_match<char32_t>(input) && char_ascii_runs_match<char16_t>(u8"ascii"sv);
+}
+
+// Contiguous input in the same encoding as the output is read a well-formed
+// run at a time rather than decoded, with the same result as decoding each
+// code point, and with base() still at the start of the current code point.
+template <exposition_only_code_unit CharT>
+constexpr bool same_encoding_runs_match(std::basic_string_view<CharT> input) {
+  auto decoded{input | std::views::filter([](CharT) { return true; })};
+  auto view{input | to_utf<CharT>};
+  auto reference{decoded | to_utf<CharT>};
+  if (!std::ranges::equal(view, reference) ||
+      !std::ranges::equal(input | to_utf_or_error<CharT>, decoded | to_utf_or_error<CharT>) ||
+      !std::ranges::equal(view | std::views::reverse, reference | std::views::reverse)) {
+    return false;
+  }
+  auto reference_it{reference.begin()};
+  for (auto it{view.begin()}; it != view.end(); ++it, ++reference_it) {
+    if (it.base() - input.begin() != std::ranges::distance(decoded.begin(), reference_it.base())) {
+      return false;
+    }
+    if (it != view.begin() && ++std::ranges::prev(it) != it) {
+      return false;
+    }
+  }
+  return true;
+}
+
+constexpr bool same_encoding_runs_test() {
+  std::u8string utf8;
+  for (int i = 0; i != 20; ++i) {
+    utf8 += u8"text that runs past the end of a 64 byte block, then ϕ学𡪇 ";
+  }
+  std::u16string const utf16{utf8 | to_utf16 | std::ranges::to<std::u16string>()};
+  std::u8string utf8_errors{utf8};
+  utf8_errors[0] = 0xFF;
+  utf8_errors[63] = 0xF0;
+  utf8_errors[700] = 0x80;
+  utf8_errors.back() = 0xE4;
+  std::u16string utf16_errors{utf16};
+  utf16_errors[0] = 0xDC00;
+  utf16_errors[63] = 0xD800;
+  utf16_errors[500] = 0xDFFF;
+  utf16_errors.back() = 0xD800;
+  return same_encoding_runs_match<char8_t>(utf8) && same_encoding_runs_match<char8_t>(utf8_errors) &&
+      same_encoding_runs_match<char16_t>(utf16) && same_encoding_runs_match<char16_t>(utf16_errors) &&
+      same_encoding_runs_match(U"Qϕ学𡪇"sv) && same_encoding_runs_match(u8""sv);
+}
+
+// The reserve hint of a long input is estimated from a sample of its code
+// units, and is within an eighth of the actual size for text as uniform as
+// this, but never above the bound that short input gets.
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr bool reserve_hint_matches(std::basic_string_view<FromType> input) {
+  auto const exact{static_cast<std::size_t>(std::ranges::distance(input | to_utf<ToType>))};
+  std::size_t const bound{input.size() * detail::max_units_per_unit<FromType, ToType>};
+  std::size_t const estimate{detail::estimated_transcoded_size<ToType>(input.data(), input.size())};
+#if defined(__cpp_lib_ranges_reserve_hint)
+  if (std::ranges::reserve_hint(input | to_utf<ToType>) != estimate) {
+    return false;
+  }
+#endif
+  if (exact > bound || estimate > bound) {
+    return false;
+  }
+  if (input.size() < detail::reserve_hint_sample_threshold) {
+    return estimate == bound;
+  }
+  return exact <= estimate + exact / 8 && estimate <= exact + exact / 8;
+}
+
+template <exposition_only_code_unit FromType>
+constexpr bool reserve_hint_matches_all(std::basic_string_view<FromType> input) {
+  return reserve_hint_matches<char8_t>(input) && reserve_hint_matches<char16_t>(input) &&
+      reserve_hint_matches<char32_t>(input);
+}
+
+constexpr bool reserve_hint_test() {
+  // The pattern is an odd number of code units long in each encoding, so
+  // that the sampled units are spread over every position in it.
+  std::u8string utf8;
+  while (utf8.size() < 32768) {
+    utf8 += u8"é人\U0001F574\U0001F600 vwxyzé";
+  }
+  std::u16string const utf16{utf8 | to_utf16 | std::ranges::to<std::u16string>()};
+  std::u32string const utf32{utf8 | to_utf32 | std::ranges::to<std::u32string>()};
+  std::u32string const ascii(8192, U'a');
+  return reserve_hint_matches_all(std::u8string_view{utf8}) && reserve_hint_matches_all(std::u16string_view{utf16}) &&
+      reserve_hint_matches_all(std::u32string_view{utf32}) && reserve_hint_matches_all(std::u32string_view{ascii}) &&
+      reserve_hint_matches_all(u8"Qϕ学𡪇"sv) && reserve_hint_matches_all(U""sv);
+}
+
+// Text made entirely of two- or four-unit sequences, starting at a sequence
+// or one unit into the input, still gets a reserve hint at least as large as
+// the result: the samples do not all fall on continuation bytes or low
+// surrogates.
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr bool reserve_hint_covers(std::basic_string_view<FromType> input) {
+  auto const exact{static_cast<std::size_t>(std::ranges::distance(input | to_utf<ToType>))};
+  std::size_t const estimate{detail::estimated_transcoded_size<ToType>(input.data(), input.size())};
+  return exact <= estimate && estimate <= input.size() * detail::max_units_per_unit<FromType, ToType>;
+}
+
+constexpr bool reserve_hint_even_period_test() {
+  std::u8string two_byte;
+  std::u8string four_byte;
+  for (int i = 0; i != 5000; ++i) {
+    two_byte += u8"é";
+    four_byte += u8"😀😀";
+  }
+  std::u8string const offset_two_byte{u8"a" + two_byte};
+  std::u8string const offset_four_byte{u8"a" + four_byte};
+  std::u16string const pairs{four_byte | to_utf16 | std::ranges::to<std::u16string>()};
+  std::u16string const offset_pairs{offset_four_byte | to_utf16 | std::ranges::to<std::u16string>()};
+  return reserve_hint_covers<char16_t>(std::u8string_view{two_byte}) &&
+      reserve_hint_covers<char32_t>(std::u8string_view{two_byte}) &&
+      reserve_hint_covers<char16_t>(std::u8string_view{offset_two_byte}) &&
+      reserve_hint_covers<char32_t>(std::u8string_view{offset_two_byte}) &&
+      reserve_hint_covers<char16_t>(std::u8string_view{four_byte}) &&
+      reserve_hint_covers<char32_t>(std::u8string_view{four_byte}) &&
+      reserve_hint_covers<char16_t>(std::u8string_view{offset_four_byte}) &&
+      reserve_hint_covers<char32_t>(std::u8string_view{offset_four_byte}) &&
+      reserve_hint_covers<char8_t>(std::u16string_view{pairs}) &&
+      reserve_hint_covers<char32_t>(std::u16string_view{pairs}) &&
+      reserve_hint_covers<char8_t>(std::u16string_view{offset_pairs}) &&
+      reserve_hint_covers<char32_t>(std::u16string_view{offset_pairs});
+}
+
+// The iterators over contiguous code units are their three base pointers and
+// the eight bytes of packed_transcoding_state, 32 bytes on 64-bit targets,
+// whichever the encodings and error kind, and so are the iterators of views
+// adapting them.
+inline constexpr std::size_t iterator_size_budget = 3 * sizeof(void*) + 8;
+static_assert(sizeof(void*) != 8 || iterator_size_budget == 32);
+
+template <class V>
+constexpr bool iterator_within_size_budget = sizeof(std::ranges::iterator_t<V>) <= iterator_size_budget;
+
+template <class V>
+constexpr bool to_utf_iterators_within_size_budget =
+    iterator_within_size_budget<to_utf_view<V, to_utf_view_error_kind::replacement, char8_t>> &&
+    iterator_within_size_budget<to_utf_view<V, to_utf_view_error_kind::replacement, char16_t>> &&
+    iterator_within_size_budget<to_utf_view<V, to_utf_view_error_kind::replacement, char32_t>> &&
+    iterator_within_size_budget<to_utf_view<V, to_utf_view_error_kind::expected, char8_t>> &&
+    iterator_within_size_budget<to_utf_view<V, to_utf_view_error_kind::expected, char16_t>> &&
+    iterator_within_size_budget<to_utf_view<V, to_utf_view_error_kind::expected, char32_t>> &&
+    iterator_within_size_budget<to_utf_view<V, to_utf_view_error_kind::assume_valid, char8_t>> &&
+    iterator_within_size_budget<to_utf_view<V, to_utf_view_error_kind::assume_valid, char16_t>> &&
+    iterator_within_size_budget<to_utf_view<V, to_utf_view_error_kind::assume_valid, char32_t>>;
+
+static_assert(to_utf_iterators_within_size_budget<std::u8string_view>);
+static_assert(to_utf_iterators_within_size_budget<std::u16string_view>);
+static_assert(to_utf_iterators_within_size_budget<std::u32string_view>);
+static_assert(iterator_within_size_budget<decltype(std::u8string_view{} | to_utf16_or_error)>);
+static_assert(iterator_within_size_budget<decltype(std::u8string_view{} | to_utf32 | std::views::reverse)>);
+
 CONSTEXPR_UNLESS_MSVC bool utf_view_test() {
   if (!input_iterator_test(std::initializer_list<char8_t>{u8'x'})) {
     return false;
@@ -1608,6 +2033,36 @@ CONSTEXPR_UNLESS_MSVC bool utf_view_test() {
   if (!input_range_equality_test()) {
     return false;
   }
+  if (!ascii_run_test()) {
+    return false;
+  }
+  if (!utf8_dfa_decoder_test()) {
+    return false;
+  }
+  if (!packed_encoder_test()) {
+    return false;
+  }
+  if (!assume_valid_test()) {
+    return false;
+  }
+  if (!assume_valid_nested_test()) {
+    return false;
+  }
+  if (!byteswap_fusion_test()) {
+    return false;
+  }
+  if (!char_ascii_runs_test()) {
+    return false;
+  }
+  if (!same_encoding_runs_test()) {
+    return false;
+  }
+  if (!reserve_hint_test()) {
+    return false;
+  }
+  if (!reserve_hint_even_period_test()) {
+    return false;
+  }
   return true;
 }
 
@@ -1643,6 +2098,8 @@ static_assert(utf_view_test());
 
 static auto const init{[] {
   framework::tests().insert({"utf_view_test", &utf_view_test});
+  framework::tests().insert({"utf8_dfa_decoder_exhaustive_test", &utf8_dfa_decoder_exhaustive_test});
+  framework::tests().insert({"packed_encoder_exhaustive_test", &packed_encoder_exhaustive_test});
   // framework::tests().insert(
   //     {"utf_view_constexpr_appendix_tests", &utf_view_constexpr_appendix_tests});
   // framework::tests().insert({"utf_view_appendix_tests", &utf_view_appendix_tests});
@@ -0,0 +1,403 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/code_unit_view.hpp>
+#include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
+#include <beman/utf_view/endian_view.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcode.hpp>
+#include <framework.hpp>
+#include <test_inputs.hpp>
+#include <test_iterators.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr bool transcode_matches_view(std::basic_string_view<FromType> input) {
+  std::basic_string<ToType> const expected{input | to_utf<ToType> |
+                                           std::ranges::to<std::basic_string<ToType>>()};
+
+  std::basic_string<ToType> contiguous(input.size() * 4, ToType{});
+  auto const contiguous_result{transcode<ToType>(input, contiguous.data())};
+  if (contiguous_result.in != input.end()) {
+    return false;
+  }
+  contiguous.resize(static_cast<std::size_t>(contiguous_result.out - contiguous.data()));
+  if (contiguous != expected) {
+    return false;
+  }
+
+  std::basic_string<ToType> inserted;
+  transcode<ToType>(input, std::back_inserter(inserted));
+  if (inserted != expected) {
+    return false;
+  }
+
+  std::vector<FromType> const list_storage(input.begin(), input.end());
+  std::basic_string<ToType> from_forward;
+  auto forward_input{list_storage | std::views::filter([](FromType) { return true; })};
+  transcode<ToType>(forward_input, std::back_inserter(from_forward));
+  return from_forward == expected;
+}
+
+template <exposition_only_code_unit FromType>
+constexpr bool transcode_matches_view_all(std::basic_string_view<FromType> input) {
+  return holds_for_each_to_type(
+      [input]<class ToType>(std::type_identity<ToType>) { return transcode_matches_view<ToType>(input); });
+}
+
+constexpr bool transcode_valid_test() {
+  return holds_for_valid_inputs([](auto input) { return transcode_matches_view_all(input); });
+}
+
+constexpr bool transcode_invalid_test() {
+  return holds_for_invalid_inputs([](auto input) { return transcode_matches_view_all(input); });
+}
+
+constexpr bool transcode_error_test() {
+  constexpr char8_t input[]{'a', 'b', 0xe0, 0x80, 'c'};
+  std::u8string_view const input_view{std::begin(input), std::end(input)};
+  {
+    std::u16string out;
+    auto const result{transcode<char16_t>(input_view, std::back_inserter(out))};
+    if (result.in != input_view.end() || result.error != utf_transcoding_error::overlong ||
+        out != u"ab\uFFFD\uFFFDc") {
+      return false;
+    }
+  }
+  {
+    char32_t out[8]{};
+    auto const result{transcode_or_error(input_view, out)};
+    if (result.in != input_view.begin() + 2 || result.out != out + 2 ||
+        result.error != utf_transcoding_error::overlong || out[0] != U'a' || out[1] != U'b') {
+      return false;
+    }
+  }
+  {
+    std::u8string out;
+    auto const result{transcode_or_error<char8_t>(u"ok"sv, std::back_inserter(out))};
+    if (result.error || out != u8"ok") {
+      return false;
+    }
+  }
+  return true;
+}
+
+constexpr bool transcode_to_utf_view_test() {
+  std::u8string_view const input{u8"x\U0001F574y"};
+  auto const view{input | to_utf16};
+  std::u32string out;
+  auto const result{transcode<char32_t>(view, std::back_inserter(out))};
+  static_assert(std::is_same_v<decltype(result.in), std::u8string_view::const_iterator>);
+  if (result.in != input.end() || out != U"x\U0001F574y") {
+    return false;
+  }
+  auto const or_error_view{input | to_utf32_or_error};
+  std::u16string out2;
+  transcode<char16_t>(or_error_view, std::back_inserter(out2));
+  return out2 == u"x\U0001F574y";
+}
+
+constexpr bool transcode_block_boundary_test() {
+  std::u8string input;
+  for (int i = 0; i != 200; ++i) {
+    input += u8"aé人\U0001F574";
+  }
+  return transcode_matches_view_all(std::u8string_view{input});
+}
+
+// Code units in the byte order this machine does not use, and the view that
+// reads them back.
+template <exposition_only_code_unit CharT>
+constexpr std::basic_string<CharT> byteswapped(std::basic_string_view<CharT> units) {
+  std::basic_string<CharT> result;
+  for (CharT const unit : units) {
+    result.push_back(std::byteswap(unit));
+  }
+  return result;
+}
+
+template <class R>
+constexpr auto from_foreign_endian(R&& r) {
+  if constexpr (std::endian::native == std::endian::little) {
+    return std::forward<R>(r) | from_big_endian;
+  } else {
+    return std::forward<R>(r) | from_little_endian;
+  }
+}
+
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr bool transcode_byteswapped_matches_view(std::basic_string_view<FromType> input) {
+  std::basic_string<FromType> const swapped{byteswapped(input)};
+  auto const view{from_foreign_endian(std::basic_string_view<FromType>{swapped})};
+  std::basic_string<ToType> const expected{input | to_utf<ToType> | std::ranges::to<std::basic_string<ToType>>()};
+  std::basic_string<ToType> out;
+  auto const result{transcode<ToType>(view, std::back_inserter(out))};
+  if (result.in != view.end() || out != expected) {
+    return false;
+  }
+  std::basic_string<ToType> or_error_out;
+  auto const or_error_result{transcode_or_error<ToType>(view, std::back_inserter(or_error_out))};
+  std::size_t const valid_size{static_cast<std::size_t>(or_error_result.in - view.begin())};
+  return or_error_out == (input.substr(0, valid_size) | to_utf<ToType> |
+                          std::ranges::to<std::basic_string<ToType>>()) &&
+      (valid_size == input.size() ? !or_error_result.error
+                                  : or_error_result.error && result.error == or_error_result.error);
+}
+
+// The same, over integers that as_char16_t or as_char32_t turn into code
+// units afterward, either as two views or as the single view that to_utf
+// fuses them into.
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr bool transcode_byteswapped_ints_match(std::basic_string_view<FromType> input) {
+  using int_type = std::conditional_t<sizeof(FromType) == 2, std::uint16_t, std::uint32_t>;
+  std::vector<int_type> swapped;
+  for (FromType const unit : input) {
+    swapped.push_back(std::byteswap(static_cast<int_type>(unit)));
+  }
+  auto const cast_view{from_foreign_endian(std::span<int_type const>{swapped}) |
+                       detail::as_code_unit_impl<FromType>{}};
+  auto const fused_view{(cast_view | to_utf<ToType>).base()};
+  std::basic_string<ToType> const expected{input | to_utf<ToType> | std::ranges::to<std::basic_string<ToType>>()};
+  std::basic_string<ToType> cast_out;
+  std::basic_string<ToType> fused_out;
+  auto const cast_result{transcode<ToType>(cast_view, std::back_inserter(cast_out))};
+  auto const fused_result{transcode<ToType>(fused_view, std::back_inserter(fused_out))};
+  return cast_result.in == cast_view.end() && cast_out == expected && fused_result.in == fused_view.end() &&
+      fused_out == expected && cast_result.error == fused_result.error;
+}
+
+template <exposition_only_code_unit FromType>
+constexpr bool transcode_byteswapped_matches_view_all(std::basic_string_view<FromType> input) {
+  return transcode_byteswapped_matches_view<char8_t>(input) &&
+      transcode_byteswapped_matches_view<char16_t>(input) && transcode_byteswapped_matches_view<char32_t>(input) &&
+      transcode_byteswapped_ints_match<char8_t>(input) && transcode_byteswapped_ints_match<char16_t>(input) &&
+      transcode_byteswapped_ints_match<char32_t>(input);
+}
+
+// Swapped input is transcoded a block of 1024 code units at a time, so put
+// surrogate pairs and errors on either side of the block boundaries.
+constexpr bool transcode_byteswap_test() {
+  std::u16string utf16;
+  for (int i = 0; i != 500; ++i) {
+    utf16 += u"aé🕴人";
+  }
+  std::u16string utf16_errors{utf16};
+  utf16_errors[1023] = 0xD800;
+  utf16_errors[2047] = 0xDC00;
+  std::u32string utf32{utf16 | to_utf32 | std::ranges::to<std::u32string>()};
+  std::u32string utf32_errors{utf32};
+  utf32_errors[1024] = 0xDC00;
+  return transcode_byteswapped_matches_view_all<char16_t>(utf16) &&
+      transcode_byteswapped_matches_view_all<char16_t>(utf16_errors) &&
+      transcode_byteswapped_matches_view_all<char32_t>(utf32) &&
+      transcode_byteswapped_matches_view_all<char32_t>(utf32_errors) &&
+      transcode_byteswapped_matches_view_all(u"\xD800"sv) && transcode_byteswapped_matches_view_all(u""sv);
+}
+
+// Code units stored as integers of the same size, read through as_char8_t
+// and the like, which transcode copies into code units a block at a time.
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr bool transcode_cast_matches_view(std::basic_string_view<FromType> input) {
+  using int_type = std::conditional_t<sizeof(FromType) == 1, char,
+                                      std::conditional_t<sizeof(FromType) == 2, std::uint16_t, std::uint32_t>>;
+  std::vector<int_type> const ints(input.begin(), input.end());
+  auto const view{ints | detail::as_code_unit_impl<FromType>{}};
+  static_assert(detail::contiguous_code_unit_cast_view<decltype(view)>);
+  std::basic_string<ToType> const expected{input | to_utf<ToType> | std::ranges::to<std::basic_string<ToType>>()};
+  std::basic_string<ToType> out;
+  auto const result{transcode<ToType>(view, std::back_inserter(out))};
+  if (result.in != view.end() || out != expected) {
+    return false;
+  }
+  std::basic_string<ToType> or_error_out;
+  auto const or_error_result{transcode_or_error<ToType>(view, std::back_inserter(or_error_out))};
+  std::size_t const valid_size{static_cast<std::size_t>(or_error_result.in - view.begin())};
+  return or_error_out == (input.substr(0, valid_size) | to_utf<ToType> |
+                          std::ranges::to<std::basic_string<ToType>>()) &&
+      (valid_size == input.size() ? !or_error_result.error
+                                  : or_error_result.error && result.error == or_error_result.error);
+}
+
+template <exposition_only_code_unit FromType>
+constexpr bool transcode_cast_matches_view_all(std::basic_string_view<FromType> input) {
+  return transcode_cast_matches_view<char8_t>(input) && transcode_cast_matches_view<char16_t>(input) &&
+      transcode_cast_matches_view<char32_t>(input);
+}
+
+// Cast input is converted a block of 1024 code units at a time, so put
+// sequences and errors on either side of the block boundaries.
+constexpr bool transcode_code_unit_cast_test() {
+  std::u8string utf8;
+  for (int i = 0; i != 300; ++i) {
+    utf8 += u8"aé🕴人";
+  }
+  std::u8string utf8_errors{utf8};
+  utf8_errors[1023] = 0xE4;
+  utf8_errors[2046] = 0xF0;
+  utf8_errors[2047] = 0x9F;
+  std::u8string utf8_lead_at_end{utf8.substr(0, 1023) + u8"\U0001F574"};
+  std::u16string const utf16{utf8 | to_utf16 | std::ranges::to<std::u16string>()};
+  std::u16string utf16_errors{utf16};
+  utf16_errors[1023] = 0xD800;
+  std::u32string const utf32{utf8 | to_utf32 | std::ranges::to<std::u32string>()};
+  std::u32string utf32_errors{utf32};
+  utf32_errors[1024] = 0xDC00;
+  for (std::size_t offset = 0; offset != 4; ++offset) {
+    if (!transcode_cast_matches_view_all<char8_t>(std::u8string_view{utf8}.substr(offset)) ||
+        !transcode_cast_matches_view_all<char8_t>(std::u8string_view{utf8_errors}.substr(offset))) {
+      return false;
+    }
+  }
+  return transcode_cast_matches_view_all<char8_t>(utf8_lead_at_end) &&
+      transcode_cast_matches_view_all<char16_t>(utf16) && transcode_cast_matches_view_all<char16_t>(utf16_errors) &&
+      transcode_cast_matches_view_all<char32_t>(utf32) && transcode_cast_matches_view_all<char32_t>(utf32_errors) &&
+      transcode_cast_matches_view_all(u8""sv);
+}
+
+// Transcoding to the same encoding copies well-formed runs as they are. With
+// or without errors, the result is that of decoding every code point, and
+// transcode_or_error copies everything before the first error.
+template <exposition_only_code_unit CharT>
+constexpr bool transcode_same_encoding_matches(std::basic_string_view<CharT> input) {
+  if (!transcode_matches_view<CharT>(input)) {
+    return false;
+  }
+  std::size_t error_offset{input.size()};
+  auto view{input | to_utf_or_error<CharT>};
+  for (auto it{view.begin()}; it != view.end(); ++it) {
+    if (!*it) {
+      error_offset = static_cast<std::size_t>(it.base() - input.begin());
+      break;
+    }
+  }
+  std::basic_string<CharT> contiguous(input.size(), CharT{});
+  auto const contiguous_result{transcode_or_error<CharT>(input, contiguous.data())};
+  contiguous.resize(static_cast<std::size_t>(contiguous_result.out - contiguous.data()));
+  std::basic_string<CharT> inserted;
+  auto const inserted_result{transcode_or_error<CharT>(input, std::back_inserter(inserted))};
+  return contiguous_result.in == input.begin() + static_cast<std::ptrdiff_t>(error_offset) &&
+      inserted_result.in == contiguous_result.in && contiguous == input.substr(0, error_offset) &&
+      inserted == contiguous && contiguous_result.error.has_value() == (error_offset != input.size());
+}
+
+// Errors at the start, at the end, and on either side of the 16384 byte
+// slices that are validated at a time.
+constexpr bool transcode_same_encoding_test() {
+  std::u8string utf8;
+  while (utf8.size() < 20000) {
+    utf8 += u8"aé🕴人 text ";
+  }
+  std::u16string const utf16{utf8 | to_utf16 | std::ranges::to<std::u16string>()};
+  std::u8string utf8_errors{utf8};
+  utf8_errors[0] = 0x80;
+  utf8_errors[16383] = 0xF0;
+  utf8_errors[16384] = 0xC0;
+  utf8_errors.back() = 0xE4;
+  std::u8string utf8_late_error{utf8};
+  utf8_late_error[16385] = 0xFF;
+  std::u16string utf16_errors{utf16};
+  utf16_errors[8191] = 0xD800;
+  utf16_errors[8192] = 0xDC00;
+  utf16_errors.back() = 0xD800;
+  constexpr char32_t invalid_utf32[]{U'A', 0xDC00, 0x110000, U'B'};
+  return transcode_same_encoding_matches<char8_t>(utf8) && transcode_same_encoding_matches<char8_t>(utf8_errors) &&
+      transcode_same_encoding_matches<char8_t>(utf8_late_error) &&
+      transcode_same_encoding_matches<char16_t>(utf16) && transcode_same_encoding_matches<char16_t>(utf16_errors) &&
+      transcode_same_encoding_matches(std::u32string_view{std::begin(invalid_utf32), std::end(invalid_utf32)}) &&
+      transcode_same_encoding_matches(u8""sv);
+}
+
+// Contiguous output whose value type is not ToType, such as std::string for
+// UTF-8 or std::uint16_t for UTF-16, is written a code unit at a time.
+constexpr bool transcode_other_output_type_test() {
+  std::u8string_view const input{u8"Qϕ学𡪇 plain ASCII text"};
+  std::u8string const expected_utf8{input};
+  std::u16string const expected_utf16{input | to_utf16 | std::ranges::to<std::u16string>()};
+  std::string chars(expected_utf8.size(), '\0');
+  auto const chars_result{transcode<char8_t>(input, chars.data())};
+  std::string iterated(expected_utf8.size(), '\0');
+  auto const iterated_result{transcode_or_error<char8_t>(input, iterated.begin())};
+  std::vector<std::uint16_t> ints(expected_utf16.size());
+  auto const ints_result{transcode<char16_t>(input, ints.data())};
+  auto const unsigned_unit{[](char c) { return static_cast<char8_t>(c); }};
+  return chars_result.out == chars.data() + chars.size() && iterated_result.out == iterated.end() &&
+      ints_result.out == ints.data() + ints.size() && std::ranges::equal(chars, expected_utf8, {}, unsigned_unit) &&
+      std::ranges::equal(iterated, expected_utf8, {}, unsigned_unit) && std::ranges::equal(ints, expected_utf16);
+}
+
+bool transcode_input_iterator_test() {
+  std::initializer_list<char8_t> arr{u8'b', 0xc3, 0xa9, u8'r'};
+  test_input_iterator it(arr);
+  std::ranges::subrange subrange{std::move(it), std::default_sentinel};
+  std::u16string out;
+  auto const result{transcode<char16_t>(std::move(subrange), std::back_inserter(out))};
+  return out == u"bér" && !result.error;
+}
+
+CONSTEXPR_UNLESS_MSVC bool transcode_test() {
+  if (!transcode_valid_test()) {
+    return false;
+  }
+  if (!transcode_invalid_test()) {
+    return false;
+  }
+  if (!transcode_error_test()) {
+    return false;
+  }
+  if (!transcode_to_utf_view_test()) {
+    return false;
+  }
+  if (!transcode_block_boundary_test()) {
+    return false;
+  }
+  if (!transcode_byteswap_test()) {
+    return false;
+  }
+  if (!transcode_code_unit_cast_test()) {
+    return false;
+  }
+  if (!transcode_same_encoding_test()) {
+    return false;
+  }
+  if (!transcode_other_output_type_test()) {
+    return false;
+  }
+  return true;
+}
+
+#ifndef _MSC_VER
+static_assert(transcode_test());
+#endif
+
+static auto const init{[] {
+  framework::tests().insert({"transcode_test", &transcode_test});
+  framework::tests().insert({"transcode_input_iterator_test", &transcode_input_iterator_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcoded_size.hpp>
+#include <framework.hpp>
+#include <test_inputs.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <cstddef>
+#include <expected>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr bool transcoded_size_matches_view(std::basic_string_view<FromType> input) {
+  auto view{input | to_utf<ToType>};
+  std::size_t const expected_size{static_cast<std::size_t>(std::ranges::distance(view))};
+  if (transcoded_size<ToType>(input) != expected_size || transcoded_size<ToType>(view) != expected_size) {
+    return false;
+  }
+  auto forward_input{input | std::views::filter([](FromType) { return true; })};
+  if (transcoded_size<ToType>(forward_input) != expected_size) {
+    return false;
+  }
+
+  std::optional<utf_validation_error> first_error;
+  auto or_error_view{input | to_utf32_or_error};
+  for (auto it = or_error_view.begin(); it != or_error_view.end(); ++it) {
+    if (auto const c{*it}; !c) {
+      first_error = {.offset = static_cast<std::size_t>(it.base() - input.begin()),
+                     .error = c.error()};
+      break;
+    }
+  }
+  auto const matches{[&](std::expected<std::size_t, utf_validation_error> const& result) {
+    return first_error ? !result && result.error() == *first_error
+                       : result && *result == expected_size;
+  }};
+  return matches(transcoded_size_or_error<ToType>(input)) &&
+      matches(transcoded_size_or_error<ToType>(forward_input));
+}
+
+template <exposition_only_code_unit FromType>
+constexpr bool transcoded_size_matches_view_all(std::basic_string_view<FromType> input) {
+  return holds_for_each_to_type(
+      [input]<class ToType>(std::type_identity<ToType>) { return transcoded_size_matches_view<ToType>(input); });
+}
+
+constexpr bool transcoded_size_valid_test() {
+  if (transcoded_size<char16_t>(u8"Qϕ学𡪇"sv) != 5 || transcoded_size<char8_t>(U"Qϕ学𡪇"sv) != 10 ||
+      transcoded_size<char32_t>(u"Qϕ学𡪇"sv) != 4) {
+    return false;
+  }
+  return holds_for_valid_inputs([](auto input) { return transcoded_size_matches_view_all(input); }) &&
+      transcoded_size_matches_view_all(std::u16string_view{});
+}
+
+constexpr bool transcoded_size_invalid_test() {
+  return holds_for_invalid_inputs([](auto input) { return transcoded_size_matches_view_all(input); });
+}
+
+CONSTEXPR_UNLESS_MSVC bool transcoded_size_test() {
+  if (!transcoded_size_valid_test()) {
+    return false;
+  }
+  if (!transcoded_size_invalid_test()) {
+    return false;
+  }
+  return true;
+}
+
+#ifndef _MSC_VER
+static_assert(transcoded_size_test());
+#endif
+
+// Inputs long enough for the vector kernels, with errors planted at every
+// offset, in each of the three encodings.
+bool transcoded_size_vectorized_test() {
+  std::u32string corpus;
+  while (corpus.size() < 100) {
+    corpus += U"Qϕ学𡪇 ascii runs, العربية, 中文, \U0001F574\U0001F600.";
+  }
+  std::u8string const utf8{corpus | to_utf8 | std::ranges::to<std::u8string>()};
+  std::u16string const utf16{corpus | to_utf16 | std::ranges::to<std::u16string>()};
+  if (!transcoded_size_matches_view_all(std::u8string_view{utf8}) ||
+      !transcoded_size_matches_view_all(std::u16string_view{utf16}) ||
+      !transcoded_size_matches_view_all(std::u32string_view{corpus})) {
+    return false;
+  }
+  constexpr char8_t utf8_corruptions[]{0x80, 0xc0, 0xe0, 0xed, 0xf4, 0xff};
+  for (std::size_t i = 0; i != utf8.size(); ++i) {
+    for (char8_t const c : utf8_corruptions) {
+      std::u8string corrupted{utf8};
+      corrupted[i] = c;
+      if (!transcoded_size_matches_view_all(std::u8string_view{corrupted})) {
+        return false;
+      }
+    }
+  }
+  constexpr char16_t utf16_corruptions[]{0xD800, 0xDBFF, 0xDC00, 0xDFFF};
+  for (std::size_t i = 0; i != utf16.size(); ++i) {
+    for (char16_t const c : utf16_corruptions) {
+      std::u16string corrupted{utf16};
+      corrupted[i] = c;
+      if (!transcoded_size_matches_view_all(std::u16string_view{corrupted})) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static auto const init{[] {
+  framework::tests().insert({"transcoded_size_test", &transcoded_size_test});
+  framework::tests().insert({"transcoded_size_vectorized_test", &transcoded_size_vectorized_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/utf_distance.hpp>
+#include <framework.hpp>
+#include <test_inputs.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+// Checks utf_distance and utf_next against std::ranges::distance and
+// iteration between every pair of positions, or every pair of about 30
+// spread out positions when there are more than that, including positions
+// in the middle of a code point.
+template <class View>
+constexpr bool utf_distance_matches(View view) {
+  std::vector<std::ranges::iterator_t<View>> positions;
+  for (auto it = view.begin();; ++it) {
+    positions.push_back(it);
+    if (it == view.end()) {
+      break;
+    }
+  }
+  auto const size{static_cast<std::ptrdiff_t>(positions.size()) - 1};
+  if (utf_distance(view) != size || std::ranges::distance(view) != size) {
+    return false;
+  }
+  std::ptrdiff_t const stride{size / 29 + 1};
+  for (std::ptrdiff_t i = 0; i <= size; i += i < 4 ? 1 : stride) {
+    if (utf_distance(positions[static_cast<std::size_t>(i)], view.end()) != size - i) {
+      return false;
+    }
+    for (std::ptrdiff_t j = i; j <= size; j += j - i < 4 ? 1 : stride + 1) {
+      auto const& first{positions[static_cast<std::size_t>(i)]};
+      auto const& last{positions[static_cast<std::size_t>(j)]};
+      if (utf_distance(first, last) != j - i || utf_next(first, j - i) != last || utf_next(last, i - j) != first) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr bool utf_distance_matches_views(std::basic_string_view<FromType> input, bool well_formed) {
+  return utf_distance_matches(input | to_utf<ToType>) && utf_distance_matches(input | to_utf_or_error<ToType>) &&
+      (!well_formed || utf_distance_matches(input | to_utf_assume_valid<ToType>));
+}
+
+template <exposition_only_code_unit FromType>
+constexpr bool utf_distance_matches_all(std::basic_string_view<FromType> input, bool well_formed) {
+  return holds_for_each_to_type([&]<class ToType>(std::type_identity<ToType>) {
+    return utf_distance_matches_views<ToType>(input, well_formed);
+  });
+}
+
+CONSTEXPR_UNLESS_MSVC bool utf_distance_test() {
+  return holds_for_valid_inputs([](auto input) { return utf_distance_matches_all(input, true); }) &&
+      holds_for_invalid_inputs([](auto input) { return utf_distance_matches_all(input, false); });
+}
+
+#ifndef _MSC_VER
+static_assert(utf_distance_test());
+#endif
+
+// Inputs long enough that utf_next skips whole blocks, and has to halve them
+// to land in the middle of one, with and without errors among them.
+bool utf_distance_blocks_test() {
+  std::u8string const utf8{repeated(u8"Qϕ学𡪇 plain ASCII text, "sv, 20000)};
+  std::u16string const utf16{repeated(u"Qϕ学𡪇 plain ASCII text, "sv, 20000)};
+  std::u32string const utf32{repeated(U"Qϕ学𡪇 plain ASCII text, "sv, 20000)};
+  std::u8string utf8_errors{utf8};
+  std::u16string utf16_errors{utf16};
+  for (std::size_t i = 5000; i < utf8_errors.size(); i += 5000) {
+    utf8_errors.insert(i, invalid_utf8_input);
+  }
+  for (std::size_t i = 5000; i < utf16_errors.size(); i += 5000) {
+    utf16_errors.insert(i, invalid_utf16_input);
+  }
+  return utf_distance_matches_all<char8_t>(utf8, true) && utf_distance_matches_all<char16_t>(utf16, true) &&
+      utf_distance_matches_all<char32_t>(utf32, true) && utf_distance_matches_all<char8_t>(utf8_errors, false) &&
+      utf_distance_matches_all<char16_t>(utf16_errors, false);
+}
+
+static auto const init{[] {
+  framework::tests().insert({"utf_distance_test", &utf_distance_test});
+  framework::tests().insert({"utf_distance_blocks_test", &utf_distance_blocks_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/utf_stream_transcoder.hpp>
+#include <framework.hpp>
+#include <test_inputs.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr std::optional<utf_transcoding_error> first_error(std::basic_string_view<FromType> input) {
+  for (auto const c : input | to_utf_or_error<ToType>) {
+    if (!c) {
+      return c.error();
+    }
+  }
+  return std::nullopt;
+}
+
+// Pushes input split at first_split and then into pieces of chunk_size code
+// units, and checks that the output and first error are those of
+// input | to_utf<ToType>.
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr bool stream_matches(std::basic_string_view<FromType> input, std::size_t first_split,
+                              std::size_t chunk_size) {
+  utf_stream_transcoder<FromType, ToType> transcoder;
+  std::basic_string<ToType> output;
+  auto out{std::back_inserter(output)};
+  out = transcoder.push(std::span<FromType const>{input.data(), first_split}, out);
+  for (std::size_t i = first_split; i < input.size(); i += chunk_size) {
+    std::size_t const size{std::min(chunk_size, input.size() - i)};
+    std::size_t const output_size{output.size()};
+    out = transcoder.push(std::span<FromType const>{input.data() + i, size}, out);
+    if (output.size() - output_size > transcoder.max_output_size(size)) {
+      return false;
+    }
+  }
+  transcoder.finish(out);
+  return transcoder.pending() == 0 &&
+      output == (input | to_utf<ToType> | std::ranges::to<std::basic_string<ToType>>()) &&
+      transcoder.error() == first_error<ToType>(input);
+}
+
+template <exposition_only_code_unit ToType, exposition_only_code_unit FromType>
+constexpr bool stream_matches_splits(std::basic_string_view<FromType> input) {
+  for (std::size_t split = 0; split <= input.size(); ++split) {
+    if (!stream_matches<ToType>(input, split, input.size() - split + 1)) {
+      return false;
+    }
+  }
+  for (std::size_t chunk_size = 1; chunk_size != 6; ++chunk_size) {
+    if (!stream_matches<ToType>(input, 0, chunk_size)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <exposition_only_code_unit FromType>
+constexpr bool stream_matches_all(std::basic_string_view<FromType> input) {
+  return holds_for_each_to_type(
+      [input]<class ToType>(std::type_identity<ToType>) { return stream_matches_splits<ToType>(input); });
+}
+
+CONSTEXPR_UNLESS_MSVC bool utf_stream_transcoder_test() {
+  auto const matches_all{[](auto input) { return stream_matches_all(input); }};
+  return holds_for_valid_inputs(matches_all) && holds_for_invalid_inputs(matches_all);
+}
+
+#ifndef _MSC_VER
+static_assert(utf_stream_transcoder_test());
+#endif
+
+// A transcoder can be reused after finish, and reset forgets the error.
+CONSTEXPR_UNLESS_MSVC bool utf_stream_transcoder_reuse_test() {
+  utf_stream_transcoder<char8_t, char16_t> transcoder;
+  std::u16string output;
+  transcoder.push(u8"a\xf0\x9f"sv, std::back_inserter(output));
+  if (transcoder.pending() != 2 || output != u"a" || transcoder.error()) {
+    return false;
+  }
+  transcoder.finish(std::back_inserter(output));
+  if (output != u"a�" || transcoder.error() != utf_transcoding_error::truncated_utf8_sequence) {
+    return false;
+  }
+  transcoder.push(u8"\xf0\x9f"sv, std::back_inserter(output));
+  transcoder.push(u8"\x95\xb4"sv, std::back_inserter(output));
+  transcoder.finish(std::back_inserter(output));
+  if (output != u"a�\U0001F574" || transcoder.error() != utf_transcoding_error::truncated_utf8_sequence) {
+    return false;
+  }
+  transcoder.reset();
+  return !transcoder.error() && transcoder.pending() == 0;
+}
+
+#ifndef _MSC_VER
+static_assert(utf_stream_transcoder_reuse_test());
+#endif
+
+static auto const init{[] {
+  framework::tests().insert({"utf_stream_transcoder_test", &utf_stream_transcoder_test});
+  framework::tests().insert({"utf_stream_transcoder_reuse_test", &utf_stream_transcoder_reuse_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/validate.hpp>
+#include <framework.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <cstddef>
+#include <expected>
+#include <iterator>
+#include <string>
+#include <string_view>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+// The expected result of validate_utf8, computed by walking to_utf32_or_error.
+constexpr std::expected<void, utf_validation_error> reference_validate(std::u8string_view input) {
+  auto view{input | to_utf32_or_error};
+  for (auto it = view.begin(); it != view.end(); ++it) {
+    if (auto const c{*it}; !c) {
+      return std::unexpected{utf_validation_error{
+          .offset = static_cast<std::size_t>(it.base() - input.begin()), .error = c.error()}};
+    }
+  }
+  return {};
+}
+
+constexpr bool validate_matches_reference(std::u8string_view input) {
+  return validate_utf8(input) == reference_validate(input);
+}
+
+constexpr bool validate_valid_test() {
+  return validate_utf8(u8""sv).has_value() && validate_utf8(u8"plain ASCII text"sv).has_value() &&
+      validate_utf8(u8"Qϕ学𡪇 and then some more text"sv).has_value() &&
+      validate_utf8(std::u8string{u8"\U0010FFFF�\u0080߿ࠀ"}).has_value();
+}
+
+constexpr bool validate_invalid_test() {
+  constexpr char8_t invalid[]{'a', 0xe0, 0x80, 0xbf};
+  auto const result{validate_utf8(std::u8string_view{std::begin(invalid), std::end(invalid)})};
+  if (result || result.error() != utf_validation_error{1, utf_transcoding_error::overlong}) {
+    return false;
+  }
+  constexpr std::u8string_view cases[]{
+      u8"\xc0\xaf"sv, u8"ab\xe0\x80\xbf"sv, u8"\xf0\x81\x82"sv, u8"x\xed\xa0\x80"sv,
+      u8"\xf4\x91\x92\x93"sv, u8"\xff"sv, u8"\xe1\x80"sv, u8"\xe1\x80z"sv,
+      u8"\xf1\xbf"sv, u8"\xf0\x90\x80"sv, u8"\x80"sv, u8"\xc3\xa9\xa9"sv,
+      u8"\xc3"sv, u8"\xf5\x80\x80\x80"sv};
+  for (std::u8string_view const input : cases) {
+    if (validate_utf8(input).has_value() || !validate_matches_reference(input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+CONSTEXPR_UNLESS_MSVC bool validate_test() {
+  if (!validate_valid_test()) {
+    return false;
+  }
+  if (!validate_invalid_test()) {
+    return false;
+  }
+  return true;
+}
+
+#ifndef _MSC_VER
+static_assert(validate_test());
+#endif
+
+// Long enough inputs to go through the vector kernels, with errors planted at
+// every offset so that they land in every lane and straddle block boundaries.
+bool validate_vectorized_test() {
+  std::u8string corpus;
+  while (corpus.size() < 200) {
+    corpus += u8"Qϕ学𡪇 ascii runs, العربية, 中文, \U0001F574\U0001F600.";
+  }
+  if (!validate_matches_reference(corpus)) {
+    return false;
+  }
+  constexpr char8_t corruptions[]{0x80, 0xbf, 0xc0, 0xc3, 0xe0, 0xed, 0xef, 0xf0, 0xf4, 0xf5, 0xff, 'a'};
+  for (std::size_t i = 0; i != corpus.size(); ++i) {
+    for (char8_t const c : corruptions) {
+      std::u8string replaced{corpus};
+      replaced[i] = c;
+      if (!validate_matches_reference(replaced)) {
+        return false;
+      }
+      std::u8string inserted{corpus};
+      inserted.insert(inserted.begin() + static_cast<std::ptrdiff_t>(i), c);
+      if (!validate_matches_reference(inserted)) {
+        return false;
+      }
+    }
+    if (!validate_matches_reference(std::u8string_view{corpus}.substr(0, i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static auto const init{[] {
+  framework::tests().insert({"validate_test", &validate_test});
+  framework::tests().insert({"validate_vectorized_test", &validate_vectorized_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/detail/constexpr_unless_msvc.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/validate.hpp>
+#include <beman/utf_view/validated_utf_view.hpp>
+#include <framework.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <algorithm>
+#include <concepts>
+#include <expected>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#endif
+
+namespace beman::utf_view::tests {
+
+using namespace std::string_view_literals;
+
+template <class V>
+inline constexpr bool is_assume_valid_view = false;
+
+template <class V, class ToType>
+inline constexpr bool is_assume_valid_view<to_utf_view<V, to_utf_view_error_kind::assume_valid, ToType>> = true;
+
+template <exposition_only_code_unit FromType>
+constexpr bool validated_transcodes_like_to_utf(std::basic_string_view<FromType> input) {
+  auto const validated{validate_utf(input)};
+  if (!validated || !std::ranges::equal(*validated, input)) {
+    return false;
+  }
+  auto utf16{*validated | to_utf16};
+  auto utf8{*validated | to_utf16 | to_utf8};
+  static_assert(is_assume_valid_view<std::remove_cvref_t<decltype(utf16)>>);
+  static_assert(is_assume_valid_view<std::remove_cvref_t<decltype(utf8)>>);
+  static_assert(!is_assume_valid_view<std::remove_cvref_t<decltype(*validated | to_utf32_or_error)>>);
+  return std::ranges::equal(utf16, input | to_utf16) && std::ranges::equal(utf8, input | to_utf8) &&
+      std::ranges::equal(*validated | to_utf32_or_error, input | to_utf32_or_error) &&
+      std::ranges::equal(*validated | to_utf32 | std::views::reverse, input | to_utf32 | std::views::reverse);
+}
+
+constexpr bool validated_valid_test() {
+  return validated_transcodes_like_to_utf(u8"Qϕ学𡪇 \U0010FFFF퟿ plain ASCII text"sv) &&
+      validated_transcodes_like_to_utf(u"Qϕ学𡪇 \U0010FFFF퟿ plain ASCII text"sv) &&
+      validated_transcodes_like_to_utf(U"Qϕ学𡪇 \U0010FFFF퟿ plain ASCII text"sv) &&
+      validated_transcodes_like_to_utf(std::u8string_view{});
+}
+
+constexpr bool validated_invalid_test() {
+  constexpr char8_t invalid_utf8[]{'a', 0xe0, 0x80, 0xbf};
+  constexpr char16_t invalid_utf16[]{u'a', u'b', 0xDC00};
+  constexpr char32_t invalid_utf32[]{U'a', 0x110000};
+  auto const utf8_result{validate_utf(std::u8string_view{std::begin(invalid_utf8), std::end(invalid_utf8)})};
+  auto const utf16_result{validate_utf(std::u16string_view{std::begin(invalid_utf16), std::end(invalid_utf16)})};
+  auto const utf32_result{validate_utf(std::u32string_view{std::begin(invalid_utf32), std::end(invalid_utf32)})};
+  return !utf8_result && utf8_result.error() == utf_validation_error{1, utf_transcoding_error::overlong} &&
+      !utf16_result && utf16_result.error() == utf_validation_error{2, utf_transcoding_error::unpaired_low_surrogate} &&
+      !utf32_result && utf32_result.error() == utf_validation_error{1, utf_transcoding_error::out_of_range};
+}
+
+constexpr bool validated_forward_range_test() {
+  std::u16string_view const input{u"x𡪇y"};
+  auto forward_input{input | std::views::filter([](char16_t) { return true; })};
+  auto validated{validate_utf(forward_input)};
+  if (!validated || !std::ranges::equal(*validated | to_utf8, input | to_utf8)) {
+    return false;
+  }
+  constexpr char16_t invalid[]{u'x', 0xD800, u'y'};
+  auto invalid_forward{std::u16string_view{std::begin(invalid), std::end(invalid)} |
+                       std::views::filter([](char16_t) { return true; })};
+  auto const invalid_result{validate_utf(invalid_forward)};
+  return !invalid_result &&
+      invalid_result.error() == utf_validation_error{1, utf_transcoding_error::unpaired_high_surrogate};
+}
+
+constexpr bool validated_assume_valid_test() {
+  validated_utf_view const view{assume_valid, u8"café"sv};
+  return std::ranges::equal(view | to_utf32, U"café"sv) && view.size() == 5 &&
+      std::ranges::equal(validated_utf_view<std::u8string_view>{} | to_utf16, u""sv);
+}
+
+// Only chains that start from a validated_utf_view are decoded without
+// checks. An assume_valid adaptor over an unvalidated to_utf view checks the
+// code units underneath that view, which can be ill-formed.
+constexpr bool validated_mixed_chain_test() {
+  constexpr char8_t invalid_utf8[]{'a', 0xe0, 0x80, 0xbf, 0xc3, 0xa9, 0xff, 'b'};
+  std::u8string_view const input{std::begin(invalid_utf8), std::end(invalid_utf8)};
+  auto utf16{input | to_utf16};
+  auto or_error{input | to_utf16_or_error};
+  static_assert(!is_assume_valid_view<decltype(utf16 | to_utf8_assume_valid)>);
+  static_assert(!is_assume_valid_view<decltype(or_error | to_utf8_assume_valid)>);
+  static_assert(!is_assume_valid_view<decltype(utf16 | to_utf8)>);
+  if (!std::ranges::equal(utf16 | to_utf8_assume_valid, input | to_utf8) ||
+      !std::ranges::equal(or_error | to_utf8_assume_valid, input | to_utf8)) {
+    return false;
+  }
+  auto const validated{validate_utf(u8"café 𡪇"sv)};
+  if (!validated) {
+    return false;
+  }
+  static_assert(is_assume_valid_view<decltype(*validated | to_utf16 | to_utf8_assume_valid)>);
+  static_assert(is_assume_valid_view<decltype(*validated | to_utf16_or_error | to_utf32)>);
+  return std::ranges::equal(*validated | to_utf16 | to_utf8_assume_valid, u8"café 𡪇"sv) &&
+      std::ranges::equal(*validated | to_utf16_or_error | to_utf32, U"café 𡪇"sv);
+}
+
+CONSTEXPR_UNLESS_MSVC bool validated_utf_view_test() {
+  if (!validated_valid_test()) {
+    return false;
+  }
+  if (!validated_invalid_test()) {
+    return false;
+  }
+  if (!validated_forward_range_test()) {
+    return false;
+  }
+  if (!validated_assume_valid_test()) {
+    return false;
+  }
+  if (!validated_mixed_chain_test()) {
+    return false;
+  }
+  return true;
+}
+
+#ifndef _MSC_VER
+static_assert(validated_utf_view_test());
+#endif
+
+static auto const init{[] {
+  framework::tests().insert({"validated_utf_view_test", &validated_utf_view_test});
+  struct {
+  } result{};
+  return result;
+}()};
+
+} // namespace beman::utf_view::tests
@@ -0,0 +1,45 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+# Round-trips sample.utf16be through beman.utf_view.tools.transcode: UTF-16BE
+# to UTF-8, then that UTF-8 to native UTF-16 and back, checking the UTF-8 both
+# times against sample.utf8.
+#
+# Expects TOOL, SOURCE_DIR, WORK_DIR and BYTE_ORDER (CMAKE_CXX_BYTE_ORDER) to
+# be defined on the command line.
+
+function(transcode from to input output)
+    execute_process(
+        COMMAND ${TOOL} -f ${from} -t ${to} ${input} ${output}
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "transcode -f ${from} -t ${to} ${input} failed: ${result}")
+    endif()
+endfunction()
+
+function(expect_same_as_sample file)
+    execute_process(
+        COMMAND ${CMAKE_COMMAND} -E compare_files ${file} ${SOURCE_DIR}/sample.utf8
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${file} differs from ${SOURCE_DIR}/sample.utf8")
+    endif()
+endfunction()
+
+if(BYTE_ORDER STREQUAL "BIG_ENDIAN")
+    set(native_utf16 utf16be)
+else()
+    set(native_utf16 utf16le)
+endif()
+
+set(utf8 ${WORK_DIR}/round_trip.utf8)
+set(utf16 ${WORK_DIR}/round_trip.utf16)
+set(utf8_again ${WORK_DIR}/round_trip_again.utf8)
+
+transcode(utf16be utf8 ${SOURCE_DIR}/sample.utf16be ${utf8})
+expect_same_as_sample(${utf8})
+
+transcode(utf8 utf16 ${utf8} ${utf16})
+transcode(${native_utf16} utf8 ${utf16} ${utf8_again})
+expect_same_as_sample(${utf8_again})
@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: BSL-1.0
+
+//   Copyright Eddie Nolan 2026.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// Transcodes a file, with the same output as to_utf over its contents, and
+// reports the throughput and the number of ill-formed subsequences that were
+// replaced with U+FFFD.
+//
+// Usage: beman.utf_view.tools.transcode [-f FROM] [-t TO] INPUT OUTPUT
+//
+// FROM is utf8 (the default), utf16le, utf16be, utf32le, or utf32be; TO is
+// utf8 (the default), utf16, or utf32, written in native byte order. OUTPUT
+// may be - for standard output. The input is mapped into memory rather than
+// read, and the output is written a block at a time.
+
+#include <beman/utf_view/config.hpp>
+#include <beman/utf_view/code_unit_view.hpp>
+#include <beman/utf_view/endian_view.hpp>
+#include <beman/utf_view/to_utf_view.hpp>
+#include <beman/utf_view/transcode.hpp>
+#if BEMAN_UTF_VIEW_USE_MODULES()
+import std;
+#else
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+using namespace beman::utf_view;
+
+// The number of input code units transcoded and written out at a time.
+constexpr std::ptrdiff_t input_block_size = 1 << 20;
+
+[[noreturn]] void fail(char const* what, char const* name) {
+  std::fprintf(stderr, "beman.utf_view.tools.transcode: %s %s: %s\n", what, name, std::strerror(errno));
+  std::exit(EXIT_FAILURE);
+}
+
+// A read-only mapping of a whole file, which the kernel is told will be read
+// front to back so that it reads ahead aggressively and drops pages behind.
+class mapped_file {
+  void* data_ = nullptr;
+  std::size_t size_ = 0;
+
+public:
+  explicit mapped_file(char const* name) {
+    int const fd{::open(name, O_RDONLY)};
+    if (fd == -1) {
+      fail("cannot open", name);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == -1) {
+      fail("cannot stat", name);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ != 0) {
+      data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data_ == MAP_FAILED) {
+        fail("cannot map", name);
+      }
+      ::madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+    ::close(fd);
+  }
+
+  mapped_file(mapped_file const&) = delete;
+  mapped_file& operator=(mapped_file const&) = delete;
+
+  ~mapped_file() {
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+    }
+  }
+
+  // The file as code units of type T. The mapping is page aligned, so this
+  // is only short of the whole file if its size is not a multiple of T.
+  template <class T>
+  std::span<T const> units() const {
+    return {static_cast<T const*>(data_), size_ / sizeof(T)};
+  }
+
+  std::size_t size() const noexcept {
+    return size_;
+  }
+};
+
+// A buffer for the output of one block of input, which is written to a file
+// descriptor in a single call.
+template <class ToType>
+class block_writer {
+  int fd_;
+  char const* name_;
+  std::vector<ToType> buf_;
+  std::size_t written_ = 0;
+
+public:
+  block_writer(int fd, char const* name, std::size_t input_block_size)
+      : fd_{fd}, name_{name}, buf_(input_block_size * detail::max_code_units<ToType>) {}
+
+  ToType* data() noexcept {
+    return buf_.data();
+  }
+
+  // Write [data(), last) out.
+  void write(ToType const* last) {
+    char const* p = reinterpret_cast<char const*>(buf_.data());
+    std::size_t n{static_cast<std::size_t>(last - buf_.data()) * sizeof(ToType)};
+    written_ += n;
+    while (n != 0) {
+      ::ssize_t const result{::write(fd_, p, n)};
+      if (result == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        fail("cannot write", name_);
+      }
+      p += result;
+      n -= static_cast<std::size_t>(result);
+    }
+  }
+
+  std::size_t bytes_written() const noexcept {
+    return written_;
+  }
+};
+
+// Transcodes input a block at a time with transcode_or_error, so that
+// well-formed stretches go through its fast path, and each time it stops at
+// an ill-formed subsequence writes the U+FFFD that to_utf would and carries
+// on after it. A sequence that is only truncated because the block ends in
+// the middle of it is left for the next block. Returns the number of
+// replacements.
+template <class ToType, class R>
+std::size_t transcode_counting_errors(R const& input, block_writer<ToType>& writer) {
+  using from_type = std::ranges::range_value_t<R>;
+  std::size_t errors{};
+  auto first = std::ranges::begin(input);
+  auto const last = std::ranges::end(input);
+  while (first != last) {
+    auto const block_last = first + std::min<std::ptrdiff_t>(last - first, input_block_size);
+    ToType* out = writer.data();
+    while (first != block_last) {
+      auto const result{transcode_or_error<ToType>(std::ranges::subrange{first, block_last}, out)};
+      first = result.in;
+      out = result.out;
+      if (!result.error ||
+          (block_last != last &&
+           block_last - first < static_cast<std::ptrdiff_t>(detail::max_code_units<from_type>))) {
+        break;
+      }
+      ++errors;
+      auto next = (std::ranges::subrange{first, last} | to_utf_or_error<ToType>).begin();
+      ++next;
+      out = transcode<ToType>(std::ranges::subrange{first, next.base()}, out).out;
+      first = next.base();
+    }
+    writer.write(out);
+  }
+  return errors;
+}
+
+template <class FromType, std::endian Endianness, class ToType>
+std::size_t transcode_file(mapped_file const& input, block_writer<ToType>& writer) {
+  if constexpr (Endianness == std::endian::native) {
+    return transcode_counting_errors<ToType>(input.units<FromType>(), writer);
+  } else {
+    using int_type = std::conditional_t<sizeof(FromType) == 2, std::uint16_t, std::uint32_t>;
+    auto const code_units{[&input] {
+      if constexpr (Endianness == std::endian::big) {
+        return input.units<int_type>() | from_big_endian;
+      } else {
+        return input.units<int_type>() | from_little_endian;
+      }
+    }()};
+    if constexpr (sizeof(FromType) == 2) {
+      return transcode_counting_errors<ToType>(code_units | as_char16_t, writer);
+    } else {
+      return transcode_counting_errors<ToType>(code_units | as_char32_t, writer);
+    }
+  }
+}
+
+template <class ToType>
+std::size_t transcode_file(std::string_view from, mapped_file const& input, block_writer<ToType>& writer) {
+  if (from == "utf16le") {
+    return transcode_file<char16_t, std::endian::little>(input, writer);
+  } else if (from == "utf16be") {
+    return transcode_file<char16_t, std::endian::big>(input, writer);
+  } else if (from == "utf32le") {
+    return transcode_file<char32_t, std::endian::little>(input, writer);
+  } else if (from == "utf32be") {
+    return transcode_file<char32_t, std::endian::big>(input, writer);
+  } else {
+    return transcode_file<char8_t, std::endian::native>(input, writer);
+  }
+}
+
+struct run_result {
+  std::size_t bytes_written;
+  std::size_t errors;
+};
+
+template <class ToType>
+run_result run(std::string_view from, mapped_file const& input, int fd, char const* output_name) {
+  block_writer<ToType> writer{fd, output_name, input_block_size};
+  std::size_t const errors{transcode_file(from, input, writer)};
+  return {.bytes_written = writer.bytes_written(), .errors = errors};
+}
+
+[[noreturn]] void usage() {
+  std::fprintf(stderr, "usage: beman.utf_view.tools.transcode [-f utf8|utf16le|utf16be|utf32le|utf32be] "
+                       "[-t utf8|utf16|utf32] INPUT OUTPUT\n");
+  std::exit(EXIT_FAILURE);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  std::string_view from{"utf8"};
+  std::string_view to{"utf8"};
+  std::vector<char const*> files;
+  for (int i = 1; i != argc; ++i) {
+    std::string_view const arg{argv[i]};
+    if ((arg == "-f" || arg == "-t") && i + 1 != argc) {
+      (arg == "-f" ? from : to) = argv[++i];
+    } else {
+      files.push_back(argv[i]);
+    }
+  }
+  if (files.size() != 2 ||
+      (from != "utf8" && from != "utf16le" && from != "utf16be" && from != "utf32le" && from != "utf32be") ||
+      (to != "utf8" && to != "utf16" && to != "utf32")) {
+    usage();
+  }
+
+  mapped_file const input{files[0]};
+  std::size_t const unit_size{from == "utf8" ? 1u : from.starts_with("utf16") ? 2u : 4u};
+  if (input.size() % unit_size != 0) {
+    std::fprintf(stderr, "beman.utf_view.tools.transcode: ignoring %zu trailing bytes of %s\n",
+                 input.size() % unit_size, files[0]);
+  }
+  std::string_view const output_name{files[1]};
+  int const fd{output_name == "-" ? STDOUT_FILENO : ::open(files[1], O_WRONLY | O_CREAT | O_TRUNC, 0666)};
+  if (fd == -1) {
+    fail("cannot open", files[1]);
+  }
+
+  auto const start{std::chrono::steady_clock::now()};
+  run_result const result{to == "utf16"   ? run<char16_t>(from, input, fd, files[1])
+                          : to == "utf32" ? run<char32_t>(from, input, fd, files[1])
+                                          : run<char8_t>(from, input, fd, files[1])};
+  double const seconds{std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+  if (fd != STDOUT_FILENO && ::close(fd) == -1) {
+    fail("cannot write", files[1]);
+  }
+
+  std::fprintf(stderr, "%zu bytes in, %zu bytes out, %zu errors, %.3f s, %.3f GiB/s\n", input.size(),
+               result.bytes_written, result.errors, seconds,
+               seconds > 0 ? static_cast<double>(input.size()) / (1 << 30) / seconds : 0.0);
+  return EXIT_SUCCESS;
+}